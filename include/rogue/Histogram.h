@@ -0,0 +1,147 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Lock free log-linear histogram
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_HISTOGRAM_H__
+#define __ROGUE_HISTOGRAM_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+#include <time.h>
+
+#include <atomic>
+#include <memory>
+
+namespace rogue {
+
+//! Return the monotonic clock in nanoseconds
+/** This is the time base used for Frame timestamps and latency tracing.
+ */
+static inline uint64_t monotonicNs() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec);
+}
+
+//! Lock free histogram
+/** Records 64-bit values, typically latencies in nanoseconds, into log-linear buckets
+ * in the style of an HDR histogram. Values below SubCount have their own bucket, above
+ * that each power of two is split into SubCount buckets, giving a relative resolution
+ * of 1/SubCount over the full 64-bit range.
+ *
+ * Values may be recorded from any number of threads concurrently without locking.
+ * Reading the statistics while values are being recorded returns a consistent
+ * approximation.
+ */
+class Histogram {
+  public:
+    //! Number of sub-bucket bits per power of two
+    static const uint32_t SubBits = 4;
+
+    //! Number of sub-buckets per power of two
+    static const uint32_t SubCount = 1 << SubBits;
+
+    //! Total number of buckets
+    static const uint32_t BucketCount = (64 - SubBits + 1) * SubCount;
+
+  private:
+    std::atomic<uint64_t> buckets_[BucketCount];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+
+  public:
+    //! Create a Histogram object and return as a HistogramPtr
+    static std::shared_ptr<rogue::Histogram> create();
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a Histogram
+    Histogram();
+
+    //! Return the bucket index for a value
+    static inline uint32_t bucketIndex(uint64_t value) {
+        uint32_t exp;
+
+        if (value < SubCount) return value;
+
+        exp = 63 - __builtin_clzll(value);
+        return ((exp - SubBits + 1) * SubCount + ((value >> (exp - SubBits)) & (SubCount - 1)));
+    }
+
+    //! Return the lowest value stored in a bucket
+    static uint64_t bucketValue(uint32_t index);
+
+    //! Record a value
+    inline void record(uint64_t value) {
+        uint64_t cur;
+
+        buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        cur = min_.load(std::memory_order_relaxed);
+        while (value < cur && !min_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+
+        cur = max_.load(std::memory_order_relaxed);
+        while (value > cur && !max_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+    }
+
+    //! Get number of recorded values
+    /** Exposed as getCount() to Python
+     */
+    uint64_t getCount();
+
+    //! Get smallest recorded value, zero if empty
+    /** Exposed as getMin() to Python
+     */
+    uint64_t getMin();
+
+    //! Get largest recorded value, zero if empty
+    /** Exposed as getMax() to Python
+     */
+    uint64_t getMax();
+
+    //! Get mean of recorded values, zero if empty
+    /** Exposed as getMean() to Python
+     */
+    double getMean();
+
+    //! Get percentile
+    /** Returns the upper bound of the bucket holding the passed percentile, limited
+     * to the largest recorded value.
+     *
+     * Exposed as getPercentile() to Python
+     * @param pct Percentile, 0.0 - 100.0
+     * @return Value at the percentile, zero if empty
+     */
+    uint64_t getPercentile(double pct);
+
+    //! Clear all recorded values
+    /** Values recorded while the reset is in progress may be partially lost.
+     *
+     * Exposed as reset() to Python
+     */
+    void reset();
+};
+
+//! Alias for using shared pointer as HistogramPtr
+typedef std::shared_ptr<rogue::Histogram> HistogramPtr;
+}  // namespace rogue
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Runtime dispatched memory copy kernels
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_MEM_COPY_H__
+#define __ROGUE_MEM_COPY_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace rogue {
+
+//! Copy kernel function type
+/** Copies size bytes from src to dst. When stream is set the kernel uses non-temporal
+ * stores, where supported, so that the destination does not displace cached data.
+ */
+typedef void (*MemCopyKernel)(void* dst, const void* src, std::size_t size, bool stream);
+
+//! Streaming copies at or below this size use memcpy
+const std::size_t MemCopySmall = 256;
+
+//! Total copy size at or above which the frame copy helpers use non-temporal stores
+const std::size_t MemCopyStreamSize = 0x100000;
+
+//! Return the named copy kernel
+/** Valid names are "memcpy", "avx2" and "avx512".
+ * @param name Kernel name
+ * @return Kernel function or NULL if the kernel is not supported by this CPU or build
+ */
+MemCopyKernel memCopyKernel(const std::string& name);
+
+//! Return the name of the copy kernel selected for this CPU
+const char* memCopyName();
+
+//! Return the copy kernel selected for this CPU
+MemCopyKernel memCopySelected();
+
+//! Copy memory with the best available kernel
+/** Cached and small copies go straight to memcpy, which is already vectorized by
+ * the C library. Larger streaming copies use the kernel selected at runtime for
+ * the current CPU.
+ * @param dst Destination pointer
+ * @param src Source pointer
+ * @param size Number of bytes to copy
+ * @param stream Set to true to use non-temporal stores for the destination
+ */
+static inline void memCopy(void* dst, const void* src, std::size_t size, bool stream) {
+    if (!stream || size <= MemCopySmall)
+        std::memcpy(dst, src, size);
+    else
+        rogue::memCopySelected()(dst, src, size, stream);
+}
+}  // namespace rogue
+
+#endif
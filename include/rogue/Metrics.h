@@ -0,0 +1,287 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Metrics registry
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_METRICS_H__
+#define __ROGUE_METRICS_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rogue/Histogram.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+
+//! Counter metric
+/** A monotonically increasing 64-bit count, updated without locking.
+ */
+class Counter {
+    std::atomic<uint64_t> value_;
+
+  public:
+    //! Create a Counter object and return as a CounterPtr
+    static std::shared_ptr<rogue::Counter> create() {
+        return std::make_shared<rogue::Counter>();
+    }
+
+    Counter() : value_(0) {}
+
+    //! Add to the counter
+    inline void inc(uint64_t count = 1) {
+        value_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    //! Set the counter, typically to clear it
+    inline void set(uint64_t value) {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    //! Get the counter value
+    inline uint64_t get() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+};
+
+//! Alias for using shared pointer as CounterPtr
+typedef std::shared_ptr<rogue::Counter> CounterPtr;
+
+//! Gauge metric
+/** A signed 64-bit level which may go up and down, updated without locking.
+ */
+class Gauge {
+    std::atomic<int64_t> value_;
+
+  public:
+    //! Create a Gauge object and return as a GaugePtr
+    static std::shared_ptr<rogue::Gauge> create() {
+        return std::make_shared<rogue::Gauge>();
+    }
+
+    Gauge() : value_(0) {}
+
+    //! Add to the gauge, use a negative value to subtract
+    inline void add(int64_t value) {
+        value_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    //! Set the gauge
+    inline void set(int64_t value) {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    //! Get the gauge value
+    inline int64_t get() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+};
+
+//! Alias for using shared pointer as GaugePtr
+typedef std::shared_ptr<rogue::Gauge> GaugePtr;
+
+class Metrics;
+
+//! Set of metrics belonging to one object
+/** Each instrumented object owns a MetricSet which registers its metrics in the global
+ * Metrics registry. Each metric is registered as <path>.<name>. The path defaults to
+ * the class prefix followed by a unique instance index, for example stream.Fifo[2], and
+ * can be changed with setPath(), typically to the path of the owning pyrogue Device.
+ * The set is only added to the registry, and only takes an instance index, once its
+ * first metric is registered or its path is read, so objects which publish nothing do
+ * not appear in the registry. The metrics are removed from the registry when the
+ * MetricSet is destroyed.
+ */
+class MetricSet {
+    friend class Metrics;
+
+    struct Metric {
+        std::string name;
+        rogue::CounterPtr counter;
+        rogue::GaugePtr gauge;
+        rogue::HistogramPtr histogram;
+    };
+
+    // Registry, held to keep it valid during static destruction
+    std::shared_ptr<rogue::Metrics> reg_;
+
+    // Class prefix, path and metrics, protected by the registry lock
+    std::string prefix_;
+    std::string path_;
+    std::vector<Metric> metrics_;
+
+    // Set is in the registry
+    bool attached_;
+
+    // Add the set to the registry, called with the registry lock held
+    void attach();
+
+    // Add a metric
+    void add(const Metric& metric);
+
+  public:
+    //! Create a MetricSet with a unique path under the passed prefix
+    static std::shared_ptr<rogue::MetricSet> create(const std::string& prefix);
+
+    // Create a MetricSet
+    explicit MetricSet(const std::string& prefix);
+
+    // Destroy the MetricSet, removing its metrics from the registry
+    ~MetricSet();
+
+    //! Register an existing counter under the passed name
+    void addCounter(const std::string& name, rogue::CounterPtr counter);
+
+    //! Register an existing gauge under the passed name
+    void addGauge(const std::string& name, rogue::GaugePtr gauge);
+
+    //! Register an existing histogram under the passed name
+    void addHistogram(const std::string& name, rogue::HistogramPtr histogram);
+
+    //! Create and register a counter
+    rogue::CounterPtr counter(const std::string& name);
+
+    //! Create and register a gauge
+    rogue::GaugePtr gauge(const std::string& name);
+
+    //! Create and register a histogram
+    rogue::HistogramPtr histogram(const std::string& name);
+
+    //! Replace the path with a unique path under a new class prefix
+    /** Used by sub-classes to replace the prefix set by their base class.
+     * @param prefix Class prefix, for example stream.Fifo
+     */
+    void setPrefix(const std::string& prefix);
+
+    //! Set the path
+    /** @param path New path, used as is
+     */
+    void setPath(const std::string& path);
+
+    //! Get the path
+    std::string getPath();
+};
+
+//! Alias for using shared pointer as MetricSetPtr
+typedef std::shared_ptr<rogue::MetricSet> MetricSetPtr;
+
+//! Metrics registry
+/** The registry holds the counters, gauges and histograms of all instrumented objects,
+ * keyed by path. The list of registered metrics is published as an immutable snapshot
+ * which is rebuilt by the first reader after a MetricSet changes. Reading all values
+ * takes one reference to the current snapshot followed by a relaxed load of each
+ * metric. No locks are taken on the metric update paths and the GIL is released while
+ * reading.
+ *
+ * Exposed to Python as rogue.Metrics with static methods.
+ */
+class Metrics {
+    friend class MetricSet;
+
+  public:
+    //! Metric types
+    static const uint8_t CounterType = 0;
+    static const uint8_t GaugeType   = 1;
+    static const uint8_t ValueType   = 2;
+
+    //! Metric value read by snapshot(), count is set for CounterType, level for GaugeType and value for ValueType
+    struct Sample {
+        std::string path;
+        uint8_t type;
+        uint64_t count;
+        int64_t level;
+        double value;
+    };
+
+  private:
+    // Published metric entry
+    struct Entry {
+        std::string path;
+        rogue::CounterPtr counter;
+        rogue::GaugePtr gauge;
+        rogue::HistogramPtr histogram;
+    };
+
+    typedef std::vector<Entry> EntryList;
+
+    // Registry lock, serializes updates
+    std::mutex mtx_;
+
+    // Registered sets
+    std::vector<rogue::MetricSet*> sets_;
+
+    // Next instance index for each class prefix
+    std::map<std::string, uint32_t> index_;
+
+    // Current snapshot, accessed with std::atomic_load and std::atomic_store
+    std::shared_ptr<const EntryList> entries_;
+
+    // Snapshot is out of date, it is rebuilt by the next reader
+    std::atomic<bool> dirty_;
+
+    // Return the current snapshot, rebuilding it if needed
+    std::shared_ptr<const EntryList> entries();
+
+    // Return a unique path for the passed prefix, called with mtx_ held
+    std::string uniquePath(const std::string& prefix);
+
+  public:
+    //! Get the registry
+    static std::shared_ptr<rogue::Metrics> instance();
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create the registry, use instance()
+    Metrics();
+
+    //! Read all metrics whose path starts with the passed prefix
+    /** Counters and gauges produce one sample each. A histogram produces samples named
+     * <path>.count, .min, .max, .p50 and .p99 of CounterType and <path>.mean of ValueType.
+     *
+     * @param samples Vector to fill, existing contents are cleared
+     * @param prefix Path prefix, empty for all metrics
+     */
+    static void snapshot(std::vector<rogue::Metrics::Sample>& samples, const std::string& prefix);
+
+    //! Get number of registered metrics
+    /** Exposed as rogue.Metrics.count() to Python
+     */
+    static uint32_t count();
+
+#ifndef NO_PYTHON
+    //! Read all metrics into a dictionary keyed by path
+    /** Exposed as rogue.Metrics.snapshot(prefix='') to Python
+     * @param prefix Path prefix, empty for all metrics
+     * @return Dictionary of path to value
+     */
+    static boost::python::dict snapshotPy(const std::string& prefix);
+#endif
+};
+
+//! Alias for using shared pointer as MetricsPtr
+typedef std::shared_ptr<rogue::Metrics> MetricsPtr;
+}  // namespace rogue
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Object recycling free lists and pooled allocator for Rogue
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_OBJECT_POOL_H__
+#define __ROGUE_OBJECT_POOL_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace rogue {
+
+//! Number of objects allocated from the heap by all free lists
+inline std::atomic<uint64_t>& objectPoolHeapCount() {
+    static std::atomic<uint64_t> count(0);
+    return count;
+}
+
+//! Free list of recycled objects
+/** Holds pointers to recycled objects or memory blocks, one list per Tag type.
+ * Each thread keeps a magazine of up to Depth entries which is used without
+ * locking. Half a magazine is moved to or from a shared list, under a mutex,
+ * when the local magazine runs empty or full. Entries are never released back
+ * to the heap.
+ */
+template <typename Tag>
+class FreeList {
+    static const uint32_t Depth = 256;
+
+    struct Global {
+        std::mutex mtx;
+        std::vector<void*> list;
+    };
+
+    struct Local {
+        std::vector<void*> list;
+        bool alive;
+
+        Local() : alive(true) {
+            list.reserve(Depth);
+        }
+
+        ~Local() {
+            alive = false;
+            Global& g = global();
+            std::lock_guard<std::mutex> lock(g.mtx);
+            g.list.insert(g.list.end(), list.begin(), list.end());
+        }
+    };
+
+    // Shared list is never destroyed so that late thread exits can still use it
+    static Global& global() {
+        static Global* g = new Global();
+        return *g;
+    }
+
+    static Local& local() {
+        static thread_local Local l;
+        return l;
+    }
+
+  public:
+    //! Get a recycled entry, returns NULL if none are available
+    static void* get() {
+        Local& l = local();
+        void* ret;
+
+        if (l.alive && l.list.empty()) {
+            Global& g = global();
+            std::lock_guard<std::mutex> lock(g.mtx);
+            uint32_t count = (g.list.size() < (Depth / 2)) ? g.list.size() : (Depth / 2);
+            l.list.insert(l.list.end(), g.list.end() - count, g.list.end());
+            g.list.resize(g.list.size() - count);
+        }
+
+        if (!l.alive || l.list.empty()) return NULL;
+
+        ret = l.list.back();
+        l.list.pop_back();
+        return ret;
+    }
+
+    //! Return an entry for later reuse
+    static void put(void* ptr) {
+        Local& l = local();
+
+        if (l.alive && l.list.size() < Depth) {
+            l.list.push_back(ptr);
+            return;
+        }
+
+        Global& g = global();
+        std::lock_guard<std::mutex> lock(g.mtx);
+        g.list.push_back(ptr);
+
+        if (l.alive) {
+            g.list.insert(g.list.end(), l.list.end() - (Depth / 2), l.list.end());
+            l.list.resize(l.list.size() - (Depth / 2));
+        }
+    }
+};
+
+//! Allocator which recycles single object allocations
+/** Standard allocator which serves single object requests from a FreeList of
+ * blocks sized for T. Used with std::allocate_shared or as the allocator for a
+ * std::shared_ptr with a custom deleter so that the object and its control
+ * block are recycled instead of going through malloc and free.
+ */
+template <typename T>
+class PoolAllocator {
+  public:
+    typedef T value_type;
+
+    PoolAllocator() {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}  // NOLINT
+
+    T* allocate(std::size_t n) {
+        void* ret;
+
+        if (n == 1 && (ret = rogue::FreeList<PoolAllocator<T> >::get()) != NULL) return static_cast<T*>(ret);
+
+        rogue::objectPoolHeapCount()++;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) {
+        if (n == 1)
+            rogue::FreeList<PoolAllocator<T> >::put(ptr);
+        else
+            ::operator delete(ptr);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return false;
+}
+}  // namespace rogue
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Shared epoll reactor for socket and device receive
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_REACTOR_H__
+#define __ROGUE_REACTOR_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
+
+namespace rogue {
+
+//! Shared I/O reactor
+/** By default each UDP interface and DMA channel receives data in its own thread,
+ * which spends most of its time waiting. A Reactor replaces these threads with a
+ * small pool of threads which wait on all registered file descriptors at once using
+ * epoll. Objects are moved to a Reactor with their setReactor() method.
+ *
+ * Descriptors are registered edge triggered and one shot: a ready descriptor is
+ * handled by one pool thread at a time, which reads until the descriptor would block
+ * before it is re-armed. Frames of one interface therefore stay in order while
+ * different interfaces are served in parallel.
+ *
+ * With busy polling enabled a pool thread keeps polling without sleeping for the
+ * configured time after the last event it handled, and falls back to a blocking
+ * wait once traffic stops. This trades CPU time for wakeup latency only while data
+ * is flowing.
+ *
+ * The Reactor is only available on Linux.
+ *
+ * Exposed to Python as rogue.Reactor()
+ */
+class Reactor {
+    // Registered descriptor
+    struct Handler {
+        int32_t fd;
+        uint32_t gen;
+        std::function<void()> func;
+        bool busy;
+        bool removed;
+    };
+
+    // Maximum events returned by one wait
+    static const uint32_t MaxEvents = 64;
+
+    std::shared_ptr<rogue::Logging> log_;
+
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
+
+    std::shared_ptr<rogue::MetricSet> metrics_;
+    std::shared_ptr<rogue::Counter> wakeCnt_;
+    std::shared_ptr<rogue::Counter> pollCnt_;
+
+    // epoll and stop event descriptors
+    int32_t epFd_;
+    int32_t stopFd_;
+
+    // Registered descriptors, protected by mtx_
+    std::mutex mtx_;
+    std::condition_variable cond_;
+    std::map<int32_t, std::shared_ptr<Handler> > handlers_;
+    uint32_t gen_;
+
+    // Busy poll time in microseconds
+    std::atomic<uint32_t> busyPoll_;
+
+    // Pool threads
+    bool threadEn_;
+    std::vector<std::thread*> threads_;
+
+    // Thread background
+    void runThread();
+
+    // Handle one event
+    void handle(uint64_t key);
+
+  public:
+    //! Create a Reactor
+    /** Exposed to Python as rogue.Reactor()
+     * @param threads Number of pool threads
+     * @return Reactor object as a ReactorPtr
+     */
+    static std::shared_ptr<rogue::Reactor> create(uint32_t threads);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a Reactor
+    explicit Reactor(uint32_t threads);
+
+    // Destroy the Reactor, stopping the pool threads
+    ~Reactor();
+
+    //! Register a descriptor
+    /** The function is called from a pool thread each time the descriptor becomes
+     * readable. It must read until the descriptor would block, since the descriptor is
+     * edge triggered.
+     * @param fd File descriptor
+     * @param func Read function
+     */
+    void add(int32_t fd, std::function<void()> func);
+
+    //! Remove a descriptor
+    /** Waits for a running read function to return, unless called from that function.
+     * @param fd File descriptor
+     */
+    void remove(int32_t fd);
+
+    //! Set the busy poll time
+    /** Exposed as setBusyPoll() to Python
+     * @param usec Time in microseconds to poll after the last event, zero to always block
+     */
+    void setBusyPoll(uint32_t usec);
+
+    //! Get the busy poll time in microseconds
+    /** Exposed as getBusyPoll() to Python
+     */
+    uint32_t getBusyPoll();
+
+    //! Get the number of registered descriptors
+    /** Exposed as count() to Python
+     */
+    uint32_t count();
+
+    //! Get the thread set of the pool threads
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+};
+
+//! Alias for using shared pointer as ReactorPtr
+typedef std::shared_ptr<rogue::Reactor> ReactorPtr;
+}  // namespace rogue
+
+#endif
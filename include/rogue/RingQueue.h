@@ -0,0 +1,343 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Lock free ring queue for Rogue
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_RING_QUEUE_H__
+#define __ROGUE_RING_QUEUE_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rogue {
+
+//! Lock free ring queue
+/** Multi-producer / multi-consumer queue with the same stop, busy and
+ * threshold semantics as rogue::Queue. Push and pop operate on a fixed array
+ * of sequence tagged cells and never take a lock on the fast path. The mutex
+ * and condition variables are only used to park a thread which finds the
+ * queue empty (pop) or at its maximum (push), and a notify is only issued
+ * when a thread is actually parked.
+ *
+ * The ring capacity is fixed at construction and rounded up to a power of two.
+ * Entries pushed while the ring is full go to a mutex protected overflow list,
+ * so the queue is unbounded unless a maximum is set with setMax(). Once the
+ * overflow list is in use new entries are appended to it until it has been
+ * drained, which keeps the entries in order.
+ */
+template <typename T>
+class RingQueue {
+    // Ring cell, sequence tags the cell as free or full for a given lap
+    struct Cell {
+        std::atomic<uint64_t> seq;
+        T data;
+    };
+
+    // Number of polls before parking on the condition variable
+    static const uint32_t SpinCount = 64;
+
+    Cell* ring_;
+    uint64_t mask_;
+
+    // Producer and consumer positions, padded to separate cache lines
+    char pad0_[64];
+    std::atomic<uint64_t> pushPos_;
+    char pad1_[64];
+    std::atomic<uint64_t> popPos_;
+    char pad2_[64];
+
+    // Parked thread tracking
+    std::mutex mtx_;
+    std::condition_variable pushCond_;
+    std::condition_variable popCond_;
+    std::atomic<uint32_t> pushWait_;
+    std::atomic<uint32_t> popWait_;
+
+    // Overflow list, entries pushed while the ring is full
+    std::mutex overMtx_;
+    std::deque<T> over_;
+    std::atomic<uint32_t> overCnt_;
+
+    std::atomic<uint32_t> max_;
+    std::atomic<uint32_t> thold_;
+    std::atomic<bool> run_;
+
+    // Attempt to insert an entry in the ring, return false if the ring is full or at the maximum
+    bool tryRingPush(T const& data) {
+        Cell* cell;
+        uint64_t pos = pushPos_.load(std::memory_order_relaxed);
+        uint32_t max = max_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            if (max > 0 &&
+                (pos - popPos_.load(std::memory_order_relaxed) + overCnt_.load(std::memory_order_relaxed)) >= max)
+                return false;
+
+            cell         = &ring_[pos & mask_];
+            int64_t diff = static_cast<int64_t>(cell->seq.load(std::memory_order_acquire)) - static_cast<int64_t>(pos);
+
+            if (diff == 0) {
+                if (pushPos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = pushPos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = data;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Append an entry to the overflow list, return false if at the maximum unless forced
+    bool overPush(T const& data, bool force) {
+        std::lock_guard<std::mutex> lock(overMtx_);
+        uint32_t max = max_.load(std::memory_order_relaxed);
+
+        if (!force && max > 0 && size() >= max) return false;
+
+        over_.push_back(data);
+        overCnt_.fetch_add(1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    // Attempt to insert an entry, return false if at the maximum
+    bool tryPush(T const& data) {
+        if (overCnt_.load(std::memory_order_acquire) == 0 && tryRingPush(data)) return true;
+        return overPush(data, false);
+    }
+
+    // Attempt to remove an entry from the ring, return false if the ring is empty
+    bool tryRingPop(T& data) {
+        Cell* cell;
+        uint64_t pos = popPos_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            cell = &ring_[pos & mask_];
+            int64_t diff =
+                static_cast<int64_t>(cell->seq.load(std::memory_order_acquire)) - static_cast<int64_t>(pos + 1);
+
+            if (diff == 0) {
+                if (popPos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = popPos_.load(std::memory_order_relaxed);
+            }
+        }
+        data       = cell->data;
+        cell->data = T();
+        cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Attempt to remove an entry, return false if the queue is empty
+    /*
+     * Ring entries are older than the overflow list, which is only used while
+     * the ring is full, so the ring is drained first.
+     */
+    bool tryPop(T& data) {
+        if (tryRingPop(data)) return true;
+        if (overCnt_.load(std::memory_order_acquire) == 0) return false;
+
+        std::lock_guard<std::mutex> lock(overMtx_);
+        if (over_.empty()) return false;
+
+        data = over_.front();
+        over_.pop_front();
+        overCnt_.fetch_sub(1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    // Wake a parked thread, only locks if someone is waiting
+    void wake(std::atomic<uint32_t>& waiters, std::condition_variable& cond) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            cond.notify_all();
+        }
+    }
+
+    // Pop an entry, blocking while empty. Returns false if stopped.
+    bool popWait(T& data) {
+        uint32_t x;
+
+        for (x = 0; run_; x++) {
+            if (tryPop(data)) {
+                wake(pushWait_, pushCond_);
+                return true;
+            }
+
+            if (x < SpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mtx_);
+            popWait_++;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (run_ && empty()) popCond_.wait(lock);
+            popWait_--;
+        }
+        return false;
+    }
+
+  public:
+    //! Default ring capacity
+    static const uint32_t DefaultCapacity = 1024;
+
+    //! Create a ring queue
+    /** @param capacity Number of entries in the ring, rounded up to a power of two,
+     * zero selects DefaultCapacity. Entries beyond the ring capacity are held in
+     * the overflow list.
+     */
+    explicit RingQueue(uint32_t capacity = 0) {
+        uint64_t size = 1;
+        uint64_t x;
+
+        if (capacity == 0) capacity = DefaultCapacity;
+        while (size < capacity) size <<= 1;
+
+        ring_ = new Cell[size];
+        mask_ = size - 1;
+        for (x = 0; x < size; x++) ring_[x].seq.store(x, std::memory_order_relaxed);
+
+        pushPos_  = 0;
+        popPos_   = 0;
+        pushWait_ = 0;
+        popWait_  = 0;
+        overCnt_  = 0;
+        max_      = 0;
+        thold_    = 0;
+        run_      = true;
+    }
+
+    RingQueue(const RingQueue&)            = delete;
+    RingQueue& operator=(const RingQueue&) = delete;
+
+    ~RingQueue() {
+        delete[] ring_;
+    }
+
+    //! Return the fixed ring capacity
+    uint32_t capacity() const {
+        return mask_ + 1;
+    }
+
+    void stop() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        run_ = false;
+        pushCond_.notify_all();
+        popCond_.notify_all();
+    }
+
+    void setMax(uint32_t max) {
+        max_ = max;
+    }
+
+    void setThold(uint32_t thold) {
+        thold_ = thold;
+    }
+
+    void push(T const& data) {
+        uint32_t x;
+
+        for (x = 0; !tryPush(data); x++) {
+            // A push released by stop() is kept, the queue no longer blocks
+            if (!run_) {
+                overPush(data, true);
+                break;
+            }
+
+            if (x < SpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mtx_);
+            pushWait_++;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (run_ && full()) pushCond_.wait(lock);
+            pushWait_--;
+        }
+        wake(popWait_, popCond_);
+    }
+
+    bool empty() {
+        return size() == 0;
+    }
+
+    bool full() {
+        uint32_t max = max_.load(std::memory_order_relaxed);
+        return (max > 0 && size() >= max);
+    }
+
+    uint32_t size() {
+        uint64_t pop  = popPos_.load(std::memory_order_acquire);
+        uint64_t push = pushPos_.load(std::memory_order_acquire);
+        return ((push > pop) ? (push - pop) : 0) + overCnt_.load(std::memory_order_acquire);
+    }
+
+    bool busy() {
+        uint32_t thold = thold_.load(std::memory_order_relaxed);
+        return (thold > 0 && size() >= thold);
+    }
+
+    void reset() {
+        T data;
+        while (tryPop(data)) {
+        }
+        wake(pushWait_, pushCond_);
+    }
+
+    //! Pop an entry, blocking while empty. Returns a default constructed entry if stopped.
+    T pop() {
+        T ret = T();
+        popWait(ret);
+        return (ret);
+    }
+
+    //! Pop up to max entries in a single call
+    /** Blocks until at least one entry is available or the queue is stopped,
+     * then drains up to max entries without blocking. Entries are appended
+     * to the passed vector.
+     * @param out Vector to append entries to
+     * @param max Maximum number of entries to remove
+     * @return Number of entries appended
+     */
+    uint32_t popN(std::vector<T>& out, uint32_t max) {
+        uint32_t count = 0;
+        T data;
+
+        if (max == 0 || !popWait(data)) return 0;
+
+        do {
+            out.push_back(data);
+            count++;
+        } while (count < max && tryPop(data));
+
+        if (count > 1) wake(pushWait_, pushCond_);
+        return count;
+    }
+};
+}  // namespace rogue
+
+#endif
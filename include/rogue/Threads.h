@@ -0,0 +1,234 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Thread registry with affinity and scheduling control
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_THREADS_H__
+#define __ROGUE_THREADS_H__
+#include "rogue/Directives.h"
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+
+class Threads;
+
+//! Set of threads belonging to one object
+/** Each object which runs internal threads owns a ThreadSet which starts the threads,
+ * sets their names and registers them in the global Threads registry under a unique
+ * path such as stream.Fifo[2]. The ThreadSet controls the CPU affinity and real time
+ * priority of all of its threads. Settings apply to the running threads and to any
+ * thread started later, so they may be changed at any time.
+ *
+ * The ThreadSet of an object is returned by its threads() method.
+ *
+ * Exposed to Python as rogue.ThreadSet
+ */
+class ThreadSet {
+    friend class Threads;
+
+    // Running thread
+    struct Entry {
+        std::string name;
+        pthread_t handle;
+        uint32_t tid;
+    };
+
+    // Registry, held to keep it valid during static destruction
+    std::shared_ptr<rogue::Threads> reg_;
+
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Path, protected by the registry lock
+    std::string path_;
+
+    // Running threads and settings, protected by mtx_
+    std::mutex mtx_;
+    std::vector<std::shared_ptr<Entry> > entries_;
+    std::vector<uint32_t> cpus_;
+    uint32_t priority_;
+    int32_t numaNode_;
+
+    // Apply the affinity setting to a thread, called with mtx_ held
+    void applyAffinity(pthread_t handle);
+
+    // Apply the priority setting to a thread, called with mtx_ held
+    void applyPriority(pthread_t handle);
+
+    // Thread entry point
+    void run(std::shared_ptr<Entry> entry, std::function<void()> func);
+
+  public:
+    //! Create a ThreadSet with a unique path under the passed prefix
+    static std::shared_ptr<rogue::ThreadSet> create(const std::string& prefix);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a ThreadSet
+    explicit ThreadSet(const std::string& prefix);
+
+    // Destroy the ThreadSet, removing its threads from the registry
+    ~ThreadSet();
+
+    //! Start a thread
+    /** The thread applies the current settings before calling the passed function.
+     * @param name Thread name, limited to 15 characters by the OS
+     * @param func Function to run
+     * @return Thread object, owned and joined by the caller
+     */
+    std::thread* start(const std::string& name, std::function<void()> func);
+
+    //! Set the CPU affinity of all threads
+    /** Exposed as setAffinity() to Python
+     * @param cpus List of CPU numbers, empty to restore the affinity of the process
+     */
+    void setAffinity(const std::vector<uint32_t>& cpus);
+
+    //! Get the configured CPU affinity, empty if not set
+    /** Exposed as getAffinity() to Python
+     */
+    std::vector<uint32_t> getAffinity();
+
+    //! Set the affinity of all threads to the CPUs of a NUMA node
+    /** Memory which the threads allocate after this call is placed on the node by the
+     * default first touch policy of the kernel.
+     *
+     * Exposed as setNumaNode() to Python
+     * @param node NUMA node number, -1 to restore the affinity of the process
+     */
+    void setNumaNode(int32_t node);
+
+    //! Get the configured NUMA node, -1 if not set
+    /** Exposed as getNumaNode() to Python
+     */
+    int32_t getNumaNode();
+
+    //! Set the real time priority of all threads
+    /** A non-zero priority selects the SCHED_FIFO policy, which typically requires the
+     * CAP_SYS_NICE capability or an rtprio limit.
+     *
+     * Exposed as setPriority() to Python
+     * @param priority SCHED_FIFO priority 1 - 99, zero for the default policy
+     */
+    void setPriority(uint32_t priority);
+
+    //! Get the configured real time priority
+    /** Exposed as getPriority() to Python
+     */
+    uint32_t getPriority();
+
+    //! Get the kernel thread IDs of the running threads
+    /** Exposed as getIds() to Python
+     */
+    std::vector<uint32_t> getIds();
+
+    //! Set the path
+    /** Exposed as setPath() to Python
+     * @param path New path, used as is
+     */
+    void setPath(const std::string& path);
+
+    //! Get the path
+    /** Exposed as getPath() to Python
+     */
+    std::string getPath();
+
+#ifndef NO_PYTHON
+    // Python versions of the list accessors
+    void setAffinityPy(boost::python::object cpus);
+    boost::python::list getAffinityPy();
+    boost::python::list getIdsPy();
+#endif
+};
+
+//! Alias for using shared pointer as ThreadSetPtr
+typedef std::shared_ptr<rogue::ThreadSet> ThreadSetPtr;
+
+//! Thread registry
+/** Lists the internal threads of all Rogue objects in one place, with their kernel
+ * thread IDs, current CPU affinity and scheduling priority.
+ *
+ * Exposed to Python as rogue.Threads with static methods.
+ */
+class Threads {
+    friend class ThreadSet;
+
+  public:
+    //! Thread information returned by list()
+    struct Info {
+        std::string path;
+        std::string name;
+        uint32_t tid;
+        std::vector<uint32_t> cpus;
+        uint32_t priority;
+    };
+
+  private:
+    // Registry lock
+    std::mutex mtx_;
+
+    // Registered sets
+    std::vector<rogue::ThreadSet*> sets_;
+
+    // Next instance index for each class prefix
+    std::map<std::string, uint32_t> index_;
+
+    // Return a unique path for the passed prefix, called with mtx_ held
+    std::string uniquePath(const std::string& prefix);
+
+  public:
+    //! Get the registry
+    static std::shared_ptr<rogue::Threads> instance();
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create the registry, use instance()
+    Threads();
+
+    //! Get information on all running threads
+    /** @param info Vector to fill, existing contents are cleared
+     */
+    static void list(std::vector<rogue::Threads::Info>& info);
+
+#ifndef NO_PYTHON
+    //! Get information on all running threads
+    /** Exposed as rogue.Threads.list() to Python
+     * @return List of dictionaries with path, name, tid, cpus and priority keys
+     */
+    static boost::python::list listPy();
+#endif
+};
+
+//! Alias for using shared pointer as ThreadsPtr
+typedef std::shared_ptr<rogue::Threads> ThreadsPtr;
+}  // namespace rogue
+
+#endif
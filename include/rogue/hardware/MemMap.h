@@ -25,7 +25,8 @@
 #include <thread>
 
 #include "rogue/Logging.h"
-#include "rogue/Queue.h"
+#include "rogue/RingQueue.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/memory/Slave.h"
 #include "rogue/interfaces/memory/Transaction.h"
 
@@ -51,6 +52,7 @@ class MemMap : public rogue::interfaces::memory::Slave {
     // Logging
     std::shared_ptr<rogue::Logging> log_;
 
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
 
@@ -58,7 +60,7 @@ class MemMap : public rogue::interfaces::memory::Slave {
     void runThread();
 
     // Queue
-    rogue::Queue<std::shared_ptr<rogue::interfaces::memory::Transaction>> queue_;
+    rogue::RingQueue<std::shared_ptr<rogue::interfaces::memory::Transaction>> queue_;
 
   public:
     //! Class factory which returns a MemMapPtr to a newly created MemMap object
@@ -81,6 +83,11 @@ class MemMap : public rogue::interfaces::memory::Slave {
     // stop interface
     void stop();
 
+    //! Get the thread set of the transaction thread
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     // Accept as transaction from the memory Master as defined in the Slave class.
     void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
 };
@@ -20,12 +20,19 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Reactor.h"
+#include "rogue/RingQueue.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -73,12 +80,21 @@ typedef std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared> AxiStreamDmaSh
  * with is requested with the zero copy flag set to false.
  */
 class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
+    //! Shares the buffer mapping of the device
+    friend class AxiStreamDmaMulti;
+
     //! Shared memory buffer tracking
     static std::map<std::string, std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared> > sharedBuffers_;
 
     //! Max number of buffers to receive at once
     static const uint32_t RxBufferCount = 100;
 
+    //! Max number of buffers to return at once
+    static const uint32_t RetBufferCount = 100;
+
+    //! Max number of frames the transmit thread takes from the queue at once
+    static const uint32_t TxBatchCount = 64;
+
     //! AxiStreamDma file descriptor
     std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared> desc_;
 
@@ -94,20 +110,88 @@ class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::int
     //! ssi insertion enable
     bool enSsi_;
 
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
 
+    //! Shared reactor, replaces the read thread when set
+    std::shared_ptr<rogue::Reactor> reactor_;
+
+    //! Frame being assembled from received buffers
+    std::shared_ptr<rogue::interfaces::stream::Frame> rxFrame_;
+
     //! Log
     std::shared_ptr<rogue::Logging> log_;
 
     //! Thread background
     void runThread(std::weak_ptr<int>);
 
-    //! Return queue
-    rogue::Queue<uint32_t> retQueue_;
+    //! Receive from the reactor
+    void rxReady();
+
+    //! Read available buffers, appending completed frames, returns the number of buffers read
+    int32_t rxRead(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
+
+    //! Buffer indexes held for a batched return, protected by retMtx_
+    uint32_t retQueue_[RetBufferCount];
+    uint32_t retCount_;
 
-    //! Return thold
+    //! Time the oldest held buffer was queued
+    uint64_t retFirst_;
+
+    //! Return threshold and maximum hold time in microseconds
     uint32_t retThold_;
+    uint32_t retTime_;
+
+    std::mutex retMtx_;
+
+    //! Timer which flushes held buffers when a reactor is used
+    int32_t retTimerFd_;
+
+    std::shared_ptr<rogue::Counter> retBatchCnt_;
+    std::shared_ptr<rogue::Counter> retBuffCnt_;
+    std::shared_ptr<rogue::Counter> retTimeCnt_;
+
+    //! Return held buffers, all of them or only once the hold time has passed
+    void retFlush(bool all);
+
+    //! Transmit queue and thread, used once setTxQueue() is called
+    rogue::RingQueue<std::shared_ptr<rogue::interfaces::stream::Frame> > txQueue_;
+    std::thread* txThread_;
+    std::atomic<bool> txEn_;
+    std::atomic<bool> txDrop_;
+
+    //! Cleared when the interface stops, ends transmit waits
+    std::atomic<bool> txRun_;
+
+    std::shared_ptr<rogue::Counter> txDropCnt_;
+    std::shared_ptr<rogue::Counter> txTimeoutCnt_;
+
+    //! Receive busy poll time in microseconds
+    std::atomic<uint32_t> busyPoll_;
+
+    //! Reads satisfied while polling, and poll and select wait times in nanoseconds
+    std::shared_ptr<rogue::Counter> pollCnt_;
+    std::shared_ptr<rogue::Counter> pollTime_;
+    std::shared_ptr<rogue::Counter> blockTime_;
+
+    //! Transmit thread background
+    void runTxThread();
+
+    //! Write a frame to the driver
+    void txFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    //! Wait for the driver to accept a copy mode write, returns false if stopped
+    bool txWait();
+
+    //! Return a list of buffer indexes to the driver
+    void retIndexes(uint32_t* indexes, uint32_t count);
+
+    //! Return timer expiration from the reactor
+    void retTimer();
+
+    //! Set the period of the return timer
+    void retTimerSet();
 
     //! Open shared buffer space
     static std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared> openShared(std::string path,
@@ -195,6 +279,120 @@ class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::int
      */
     void dmaAck();
 
+    //! Get the thread set of the receive thread
+    /** Exposed to python as threads()
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
+    //! Receive using a shared reactor
+    /** Stops the read thread and registers the device with the passed Reactor,
+     * which then reads the DMA buffers until the interface is stopped.
+     *
+     * Exposed to python as setReactor()
+     * @param reactor Reactor object
+     */
+    void setReactor(std::shared_ptr<rogue::Reactor> reactor);
+
+    //! Configure batched return of zero copy buffers
+    /** Received zero copy buffers are returned to the driver once the Frame which
+     * holds them is released. Returning buffers in batches reduces the number of
+     * driver calls at high frame rates. Released buffers are held until count buffers
+     * are waiting or until the oldest held buffer has been held for time microseconds.
+     * A count of 1 returns each buffer immediately. Held buffers are returned when the
+     * interface is stopped.
+     *
+     * Batching defaults to 80 buffers with a 1 millisecond hold time when the driver
+     * has 1000 or more buffers, and is disabled otherwise.
+     *
+     * Exposed to python as setRetBatch()
+     * @param count Number of buffers per return batch, 1 to 100
+     * @param time Maximum hold time in microseconds
+     */
+    void setRetBatch(uint32_t count, uint32_t time);
+
+    //! Get the number of buffer return calls to the driver
+    /** Exposed to python as getRetBatchCount()
+     */
+    uint64_t getRetBatchCount();
+
+    //! Get the number of buffers returned to the driver
+    /** Exposed to python as getRetBuffCount()
+     */
+    uint64_t getRetBuffCount();
+
+    //! Get the number of return batches sent because the hold time expired
+    /** Exposed to python as getRetTimeoutCount()
+     */
+    uint64_t getRetTimeoutCount();
+
+    //! Set the receive busy poll time
+    /** By default the receive thread waits in select() for the driver to provide
+     * buffers, which adds a wakeup latency to each received frame. With a busy poll
+     * time the receive thread keeps reading the driver without sleeping for that
+     * many microseconds after the last received buffer, and only falls back to
+     * select() once no buffer has arrived within the window. This trades a CPU core
+     * for lower receive latency while data is flowing. The time spent polling without
+     * receiving and the time spent waiting in select() are reported by getBusyPollTime()
+     * and getBlockTime(). A reactor, see setReactor(), has its own busy poll setting.
+     *
+     * Exposed to python as setBusyPoll()
+     * @param usec Time in microseconds to poll after the last buffer, zero to always wait
+     */
+    void setBusyPoll(uint32_t usec);
+
+    //! Get the receive busy poll time in microseconds
+    /** Exposed to python as getBusyPoll()
+     */
+    uint32_t getBusyPoll();
+
+    //! Get the number of reads which returned buffers while polling
+    /** Exposed to python as getBusyPollCount()
+     */
+    uint64_t getBusyPollCount();
+
+    //! Get the time spent polling without receiving buffers, in nanoseconds
+    /** Exposed to python as getBusyPollTime()
+     */
+    uint64_t getBusyPollTime();
+
+    //! Get the time spent waiting for buffers in select(), in nanoseconds
+    /** Exposed to python as getBlockTime()
+     */
+    uint64_t getBlockTime();
+
+    //! Enable the transmit queue
+    /** By default frames are written to the driver in the thread which calls
+     * acceptFrame(), which waits while the driver has no room for the frame.
+     * Enabling the transmit queue moves the writes to a dedicated thread, so
+     * acceptFrame() only adds the frame to a queue and returns. When the queue
+     * holds depth frames the caller either waits for room or the frame is dropped,
+     * depending on the drop flag. The queue can not be disabled once enabled. It
+     * should be enabled before frames are sent.
+     *
+     * Exposed to python as setTxQueue()
+     * @param depth Maximum number of queued frames
+     * @param drop Drop frames when the queue is full instead of waiting
+     */
+    void setTxQueue(uint32_t depth, bool drop);
+
+    //! Get the number of frames in the transmit queue
+    /** Exposed to python as getTxQueueDepth()
+     */
+    uint32_t getTxQueueDepth();
+
+    //! Get the number of frames dropped because the transmit queue was full
+    /** Exposed to python as getTxDropCount()
+     */
+    uint64_t getTxDropCount();
+
+    //! Get the number of transmit timeouts
+    /** Counts each timeout period spent waiting for the driver to accept
+     * a write or provide a transmit buffer, see setTimeout().
+     *
+     * Exposed to python as getTxTimeoutCount()
+     */
+    uint64_t getTxTimeoutCount();
+
     // Generate a Frame. Called from master
     std::shared_ptr<rogue::interfaces::stream::Frame> acceptReq(uint32_t size, bool zeroCopyEn);
 
@@ -0,0 +1,185 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ *      AxiStreamDma Multiple Destination Receiver Class
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_HARDWARE_AXI_AXI_STREAM_DMA_MULTI_H__
+#define __ROGUE_HARDWARE_AXI_AXI_STREAM_DMA_MULTI_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
+#include "rogue/hardware/axi/AxiStreamDma.h"
+#include "rogue/interfaces/stream/Fifo.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Pool.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace hardware {
+namespace axi {
+
+//! AXI Stream DMA Multiple Destination Receiver Class
+/** This class receives frames for a list of destinations using a single file
+ * descriptor and a single receive thread. Received buffers are read in bulk and
+ * each completed frame is passed to the output Master of its destination. With
+ * one AxiStreamDma instance per destination each destination has its own file
+ * descriptor and receive thread, so the number of threads grows with the number
+ * of lanes. This class keeps a single receive thread for any number of lanes.
+ *
+ * Each destination can optionally be decoupled from the receive thread by a Fifo,
+ * so a slow receiver does not stall the other destinations. Frames are dropped by
+ * the Fifo of a destination once its depth is reached.
+ *
+ * This class only receives. Frames are transmitted using AxiStreamDma instances
+ * opened on the same device.
+ *
+ * Unlike AxiStreamDma this class does not support batched buffer returns, busy
+ * polling or a shared Reactor. Each zero copy buffer is returned to the driver
+ * with its own call when the last frame holding it is released, and the receive
+ * thread always waits in select().
+ */
+class AxiStreamDmaMulti : public rogue::interfaces::stream::Pool {
+    //! Max number of buffers to receive at once
+    static const uint32_t RxBufferCount = 100;
+
+    //! Number of supported destinations, one per bit of the driver destination mask
+    static const uint32_t DestCount = 4096;
+
+    //! Per destination output
+    struct Dest {
+        //! Output Master
+        std::shared_ptr<rogue::interfaces::stream::Master> master;
+
+        //! Optional Fifo between the Master and the receivers
+        std::shared_ptr<rogue::interfaces::stream::Fifo> fifo;
+
+        //! Frame being assembled from received buffers
+        std::shared_ptr<rogue::interfaces::stream::Frame> frame;
+
+        //! Frames completed by the current read
+        std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> > frames;
+    };
+
+    //! Destination table indexed by destination, NULL for unused destinations
+    std::vector<Dest*> table_;
+
+    //! Destination storage
+    std::vector<std::shared_ptr<Dest> > dests_;
+
+    //! Shared memory buffers
+    std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared> desc_;
+
+    //! Process specific FD
+    int32_t fd_;
+
+    //! ssi insertion enable
+    bool enSsi_;
+
+    std::shared_ptr<rogue::MetricSet> metrics_;
+    std::shared_ptr<rogue::Counter> unmatchedCnt_;
+
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
+    std::thread* thread_;
+    bool threadEn_;
+
+    //! Log
+    std::shared_ptr<rogue::Logging> log_;
+
+    //! Thread background
+    void runThread();
+
+    //! Read available buffers and pass completed frames to the outputs
+    void rxRead();
+
+  public:
+    //! Class factory which returns a AxiStreamDmaMultiPtr to a newly created AxiStreamDmaMulti object
+    /** Exposed to Python as rogue.hardware.axi.AxiStreamDmaMulti()
+     *
+     * See AxiStreamDma::create() for the destination and SSI settings.
+     * @param path Path to device. i.e /dev/datadev_0
+     * @param dests List of destinations to receive
+     * @param ssiEnable Enable SSI user fields
+     * @param fifoDepth Depth of the Fifo added to each destination, 0 for no Fifo
+     * @return AxiStreamDmaMulti pointer (AxiStreamDmaMultiPtr)
+     */
+    static std::shared_ptr<rogue::hardware::axi::AxiStreamDmaMulti> create(std::string path,
+                                                                           const std::vector<uint32_t>& dests,
+                                                                           bool ssiEnable,
+                                                                           uint32_t fifoDepth);
+
+#ifndef NO_PYTHON
+    // Python constructor taking the destinations as a list
+    static std::shared_ptr<rogue::hardware::axi::AxiStreamDmaMulti> createPy(std::string path,
+                                                                             boost::python::object dests,
+                                                                             bool ssiEnable,
+                                                                             uint32_t fifoDepth);
+#endif
+
+    // Setup class in python
+    static void setup_python();
+
+    // Class Creator
+    AxiStreamDmaMulti(std::string path, const std::vector<uint32_t>& dests, bool ssiEnable, uint32_t fifoDepth);
+
+    // Destructor
+    ~AxiStreamDmaMulti();
+
+    //! Stop the interface
+    /** Exposed to python as _stop()
+     */
+    void stop();
+
+    //! Get the output of a destination
+    /** Returns the Fifo of the destination when enabled, otherwise the output Master.
+     *
+     * Exposed to python as output()
+     * @param dest Destination index
+     * @return Output Master of the destination
+     */
+    std::shared_ptr<rogue::interfaces::stream::Master> output(uint32_t dest);
+
+    //! Get the number of buffers received for destinations which are not in the list
+    /** Exposed to python as getUnmatchedCount()
+     */
+    uint64_t getUnmatchedCount();
+
+    //! Get the thread set of the receive thread
+    /** Exposed to python as threads()
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
+    // Process Buffer Return
+    void retBuffer(uint8_t* data, uint32_t meta, uint32_t rawSize);
+};
+
+//! Alias for using shared pointer as AxiStreamDmaMultiPtr
+typedef std::shared_ptr<rogue::hardware::axi::AxiStreamDmaMulti> AxiStreamDmaMultiPtr;
+
+}  // namespace axi
+}  // namespace hardware
+};  // namespace rogue
+
+#endif
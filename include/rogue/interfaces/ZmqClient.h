@@ -23,6 +23,7 @@
 #include <thread>
 
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 
 #ifndef NO_PYTHON
     #include <boost/python.hpp>
@@ -49,6 +50,7 @@ class ZmqClient {
 
     bool waitRetry_;
 
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
     bool running_;
@@ -77,6 +79,9 @@ class ZmqClient {
 
     std::string valueDisp(const std::string& path);
 
+    //! Get the thread set of the update thread
+    std::shared_ptr<rogue::ThreadSet> threads();
+
 #ifndef NO_PYTHON
     boost::python::object send(boost::python::object data);
 
@@ -23,6 +23,7 @@
 #include <thread>
 
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 
 #ifndef NO_PYTHON
     #include <boost/python.hpp>
@@ -45,6 +46,7 @@ class ZmqServer {
     // Zeromq string response port
     void* zmqStr_;
 
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* rThread_;
     std::thread* sThread_;
     bool threadEn_;
@@ -79,6 +81,9 @@ class ZmqServer {
 
     uint16_t port();
 
+    //! Get the thread set of the server threads
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     void stop();
     void start();
 };
@@ -25,6 +25,7 @@
 #include <thread>
 
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/memory/Slave.h"
 
 namespace rogue {
@@ -64,6 +65,7 @@ class TcpClient : public rogue::interfaces::memory::Slave {
     std::shared_ptr<rogue::Logging> bridgeLog_;
 
     // Thread
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
 
@@ -100,6 +102,11 @@ class TcpClient : public rogue::interfaces::memory::Slave {
     // Stop the interface
     void stop();
 
+    //! Get the thread set of the receive thread
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     // Process transaction from Master
     void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
 };
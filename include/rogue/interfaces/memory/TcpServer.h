@@ -25,6 +25,7 @@
 #include <thread>
 
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/memory/Master.h"
 
 namespace rogue {
@@ -61,6 +62,7 @@ class TcpServer : public rogue::interfaces::memory::Master {
     std::shared_ptr<rogue::Logging> bridgeLog_;
 
     // Thread
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
 
@@ -94,6 +96,11 @@ class TcpServer : public rogue::interfaces::memory::Master {
 
     // Stop the interface
     void stop();
+
+    //! Get the thread set of the receive thread
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
 };
 
 //! Alias for using shared pointer as TcpServerPtr
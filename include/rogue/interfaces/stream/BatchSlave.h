@@ -0,0 +1,194 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Stream slave which delivers frames in batches
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_STREAM_BATCH_SLAVE_H__
+#define __ROGUE_INTERFACES_STREAM_BATCH_SLAVE_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace interfaces {
+namespace stream {
+
+//! Stream slave which delivers frames in batches
+/** The BatchSlave collects received frames and passes them to the acceptBatch() method
+ * in an independent thread. A batch is delivered once maxCount frames have been collected
+ * or once maxTime microseconds have passed since the first frame of the batch arrived,
+ * whichever comes first. Frames which arrive while a batch is being processed are held
+ * for the next batch, so a batch may hold more than maxCount frames.
+ *
+ * The BatchSlave is intended for Python receivers. Python subclasses implement
+ * _acceptFrames(self, frames) which is called with a list of frames. The Python lock is
+ * acquired once per batch instead of once per frame, which greatly reduces the overhead
+ * of receiving small frames in Python. The master sending frames to the BatchSlave does
+ * not wait for the Python receiver.
+ *
+ * By default the number of held frames is not limited. A receiver which is slower than the
+ * source, for example one fed by zero copy DMA buffers, should limit the depth with
+ * setMaxDepth(). Once the limit is reached the master either waits for the next batch to
+ * be taken or the frame is dropped.
+ */
+class BatchSlave : public rogue::interfaces::stream::Slave {
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Collected frames, protected by mtx_
+    std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> > queue_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+
+    // Signalled when a batch is taken from a full queue
+    std::condition_variable spaceCond_;
+
+    // Batch limits
+    uint32_t maxCount_;
+    uint32_t maxTime_;
+
+    // Queue limit, protected by mtx_
+    uint32_t maxDepth_;
+    bool drop_;
+
+    std::shared_ptr<rogue::Counter> batchCnt_;
+    std::shared_ptr<rogue::Counter> dropCnt_;
+
+    // Queue is at the depth limit, called with mtx_ held
+    bool full();
+
+    // Wait for space in the queue, returns false if the frame must be dropped
+    bool waitSpace(std::unique_lock<std::mutex>& lock);
+
+    // Delivery thread
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
+    std::thread* thread_;
+
+    // Thread background
+    void runThread();
+
+  protected:
+    // Delivery thread enable
+    std::atomic<bool> threadEn_;
+
+    // Stop the delivery thread, called by the destructor of sub-classes
+    void stopThread();
+
+  public:
+    //! Create a BatchSlave object and return as a BatchSlavePtr
+    /** Exposed as rogue.interfaces.stream.BatchSlave() to Python
+     * @param maxCount Number of frames which completes a batch
+     * @param maxTime Maximum time in microseconds to wait for a batch to complete
+     * @return BatchSlave object as a BatchSlavePtr
+     */
+    static std::shared_ptr<rogue::interfaces::stream::BatchSlave> create(uint32_t maxCount, uint32_t maxTime);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a BatchSlave object.
+    BatchSlave(uint32_t maxCount, uint32_t maxTime);
+
+    // Destroy the BatchSlave
+    virtual ~BatchSlave();
+
+    //! Get the number of delivered batches
+    /** Exposed as batchCnt() to Python
+     * @return Number of batches passed to acceptBatch()
+     */
+    uint64_t batchCnt();
+
+    //! Limit the number of held frames
+    /** Exposed as setMaxDepth() to Python
+     * @param depth Maximum number of held frames, zero for no limit
+     * @param drop Drop frames when the limit is reached instead of waiting
+     */
+    void setMaxDepth(uint32_t depth, bool drop);
+
+    //! Get the number of dropped frames
+    /** Exposed as dropCnt() to Python
+     * @return Number of frames dropped because the depth limit was reached
+     */
+    uint64_t dropCnt();
+
+    //! Get the thread set of the delivery thread
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
+    // Receive frame from Master
+    void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    // Receive a batch of frames from Master
+    void acceptFrames(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
+
+    //! Process a batch of frames
+    /** Called from the delivery thread. The default implementation passes each frame
+     * to the base Slave::acceptFrame(). Frames remaining in the vector are released by
+     * the caller.
+     *
+     * Implemented as _acceptFrames(self, frames) in Python subclasses, with frames
+     * passed as a list.
+     * @param frames Batch of frames
+     */
+    virtual void acceptBatch(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
+};
+
+//! Alias for using shared pointer as BatchSlavePtr
+typedef std::shared_ptr<rogue::interfaces::stream::BatchSlave> BatchSlavePtr;
+
+#ifndef NO_PYTHON
+
+// Batch slave class, wrapper to enable python overload of virtual methods
+class BatchSlaveWrap : public rogue::interfaces::stream::BatchSlave,
+                       public boost::python::wrapper<rogue::interfaces::stream::BatchSlave> {
+    // Cached python override, looked up on the first batch
+    boost::python::object override_;
+    bool overrideInit_;
+    bool overrideSelf_;
+
+  public:
+    // Create a BatchSlaveWrap object
+    BatchSlaveWrap(uint32_t maxCount, uint32_t maxTime);
+
+    // Destroy the BatchSlaveWrap
+    ~BatchSlaveWrap();
+
+    // Process a batch of frames
+    void acceptBatch(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
+};
+
+typedef std::shared_ptr<rogue::interfaces::stream::BatchSlaveWrap> BatchSlaveWrapPtr;
+#endif
+
+}  // namespace stream
+}  // namespace interfaces
+}  // namespace rogue
+#endif
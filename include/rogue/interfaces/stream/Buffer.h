@@ -38,6 +38,10 @@ class Frame;
  * space which may be required by protocol layers. Direct interaction with the Buffer
  * class is an advanced topic, most users will simply use a FrameIterator to access
  * Frame and Buffer data. The Buffer class is not available in Python.
+ *
+ * A Buffer can also be a view of a byte range within another Buffer, see createView().
+ * A view does not own memory, it holds a reference to the parent Buffer which keeps
+ * the parent data allocated until all views are released.
  */
 class Buffer {
     // Pointer to entity which allocated this buffer
@@ -46,6 +50,9 @@ class Buffer {
     // Pointer to frame containing this buffer
     std::weak_ptr<rogue::interfaces::stream::Frame> frame_;
 
+    // Buffer which owns the data when this buffer is a view
+    std::shared_ptr<rogue::interfaces::stream::Buffer> parent_;
+
     // Pointer to raw data buffer. Raw pointer is used here!
     uint8_t* data_;
 
@@ -73,6 +80,21 @@ class Buffer {
     // Error state
     uint32_t error_;
 
+    // Setup buffer state, used by constructor and when recycling
+    void init(std::shared_ptr<rogue::interfaces::stream::Pool> source,
+              void* data,
+              uint32_t meta,
+              uint32_t size,
+              uint32_t alloc);
+
+    // Return data to the source pool
+    void release();
+
+    // Deleter which recycles the Buffer instead of destroying it
+    struct Recycle {
+        void operator()(rogue::interfaces::stream::Buffer* buff) const;
+    };
+
   public:
     //! Alias for using uint8_t * as Buffer::iterator
     typedef uint8_t* iterator;
@@ -93,6 +115,24 @@ class Buffer {
         uint32_t size,
         uint32_t alloc);
 
+    //! Create a view of a byte range within another Buffer
+    /** The returned Buffer references payload bytes of the parent buffer without
+     * copying. The view has no header or tail reservation and its payload is set to the
+     * passed size. Data written through the view is visible in the parent and in any
+     * other overlapping view. The parent Buffer, and the memory it returns to its Pool,
+     * is kept until the view is released.
+     *
+     * Not exposed to Python
+     * @param parent Buffer pointer (BufferPtr) to create the view of
+     * @param offset Offset of the view relative to the start of the parent payload
+     * @param size Size of the view in bytes
+     * @return View Buffer pointer as BufferPtr
+     */
+    static std::shared_ptr<rogue::interfaces::stream::Buffer> createView(
+        std::shared_ptr<rogue::interfaces::stream::Buffer> parent,
+        uint32_t offset,
+        uint32_t size);
+
     // Create a buffer.
     Buffer(std::shared_ptr<rogue::interfaces::stream::Pool> source,
            void* data,
@@ -0,0 +1,127 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Stream channel demultiplexer
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_STREAM_DEMUX_H__
+#define __ROGUE_INTERFACES_STREAM_DEMUX_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace rogue {
+namespace interfaces {
+namespace stream {
+
+//! Stream channel demultiplexer
+/** The Demux splits a stream carrying several channels, see Frame::getChannel(), into
+ * one output Master per channel. It replaces a set of Filter objects attached to the
+ * same Master: each frame costs a single table lookup instead of one call per Filter.
+ *
+ * The output for a channel is created by the first call to output(), after which any
+ * number of Slave objects may be attached to it. Frames for a channel without an output
+ * are dropped and counted. Each output can optionally drop frames with a non-zero error
+ * field, see setDropErrors(). Batches received through acceptFrames() are forwarded as
+ * batches of consecutive frames with the same channel.
+ */
+class Demux : public rogue::interfaces::stream::Slave {
+    // Output channel
+    struct Output {
+        std::shared_ptr<rogue::interfaces::stream::Master> master;
+        std::atomic<bool> dropErrors;
+        std::shared_ptr<rogue::Counter> dropCnt;
+    };
+
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Protects output creation
+    std::mutex mtx_;
+
+    // Channel to output table, entries are set once and owned by outputs_
+    std::atomic<Output*> table_[256];
+    std::vector<std::shared_ptr<Output> > outputs_;
+
+    // Frames for channels without an output
+    std::shared_ptr<rogue::Counter> unmatchedCnt_;
+
+    // Return the output for a frame, NULL if the frame is dropped
+    Output* route(std::shared_ptr<rogue::interfaces::stream::Frame>& frame);
+
+  public:
+    //! Create a Demux object and return as a DemuxPtr
+    /** Exposed as rogue.interfaces.stream.Demux() to Python
+     * @return Demux object as a DemuxPtr
+     */
+    static std::shared_ptr<rogue::interfaces::stream::Demux> create();
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a Demux object
+    Demux();
+
+    // Destroy the Demux
+    ~Demux();
+
+    //! Get the output for a channel
+    /** The output is created on the first call for a channel.
+     *
+     * Exposed as output() to Python
+     * @param channel Frame channel
+     * @return Master object which forwards the frames of the channel
+     */
+    std::shared_ptr<rogue::interfaces::stream::Master> output(uint8_t channel);
+
+    //! Set the error drop flag of a channel output
+    /** Exposed as setDropErrors() to Python
+     * @param channel Frame channel, the output is created if it does not exist
+     * @param drop Set to true to drop frames with a non-zero error field
+     */
+    void setDropErrors(uint8_t channel, bool drop);
+
+    //! Get the number of errored frames dropped by a channel output
+    /** Exposed as dropCnt() to Python
+     * @param channel Frame channel
+     * @return Drop count, zero if the channel has no output
+     */
+    uint64_t dropCnt(uint8_t channel);
+
+    //! Get the number of frames dropped because their channel has no output
+    /** Exposed as unmatchedCnt() to Python
+     */
+    uint64_t unmatchedCnt();
+
+    // Receive frame from Master
+    void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    // Receive a batch of frames from Master
+    void acceptFrames(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
+};
+
+//! Alias for using shared pointer as DemuxPtr
+typedef std::shared_ptr<rogue::interfaces::stream::Demux> DemuxPtr;
+}  // namespace stream
+}  // namespace interfaces
+}  // namespace rogue
+#endif
@@ -20,10 +20,17 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/RingQueue.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -44,6 +51,10 @@ namespace stream {
  *
  * The Fifo supports a maximum depth to be configured. After this depth is reached
  * new incoming Frame objects are dropped.
+ *
+ * Alternatively the Fifo can be put in backpressure mode with setBackpressure(). Once
+ * the high watermark is reached acceptFrame() blocks until the Fifo has drained to the
+ * low watermark, stalling the upstream Master instead of dropping data.
  */
 class Fifo : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
     std::shared_ptr<rogue::Logging> log_;
@@ -54,18 +65,40 @@ class Fifo : public rogue::interfaces::stream::Master, public rogue::interfaces:
     bool noCopy_;
 
     // Drop frame counter
-    std::size_t dropFrameCnt_;
+    std::shared_ptr<rogue::Counter> dropFrameCnt_;
+
+    // Backpressure watermarks and timeout in microseconds, disabled when highWater_ is zero
+    std::atomic<uint32_t> highWater_;
+    std::atomic<uint32_t> lowWater_;
+    uint32_t bpTimeout_;
+
+    // Backpressure state, protected by bpMtx_
+    std::mutex bpMtx_;
+    std::condition_variable bpCond_;
+    std::atomic<uint32_t> bpWait_;
+    std::atomic<bool> blocked_;
+
+    // Backpressure wait counter and total blocked time in nanoseconds
+    std::shared_ptr<rogue::Counter> blockCnt_;
+    std::shared_ptr<rogue::Counter> blockTime_;
+
+    // Maximum frames removed from the queue per wakeup
+    static const uint32_t PopBatch = 64;
 
     // Queue
-    rogue::Queue<std::shared_ptr<rogue::interfaces::stream::Frame>> queue_;
+    rogue::RingQueue<std::shared_ptr<rogue::interfaces::stream::Frame>> queue_;
 
     // Transmission thread
     bool threadEn_;
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
 
     // Thread background
     void runThread();
 
+    // Wait for the Fifo to drain to the low watermark, false on timeout
+    bool waitDrain(uint32_t highWater);
+
   public:
     //! Create a Fifo object and return as a FifoPtr
     /** Exposed as rogue.interfaces.stream.Fifo() to Python
@@ -94,8 +127,39 @@ class Fifo : public rogue::interfaces::stream::Master, public rogue::interfaces:
     // Clear counters
     void clearCnt();
 
+    //! Enable backpressure mode
+    /** In backpressure mode frames are not dropped when maxDepth is reached. Instead
+     * acceptFrame() blocks once the Fifo holds highWater frames, until the transmission
+     * thread has drained it to lowWater frames. A Frame which can not be queued within
+     * the timeout is dropped and counted in dropCnt().
+     *
+     * Exposed as setBackpressure() to Python
+     * @param highWater Frame count at which acceptFrame() blocks, zero to return to drop mode
+     * @param lowWater Frame count at which blocked callers resume, less than highWater
+     * @param timeout Maximum wait in microseconds, zero to wait forever
+     */
+    void setBackpressure(uint32_t highWater, uint32_t lowWater, uint32_t timeout);
+
+    //! Get number of times acceptFrame() blocked in backpressure mode
+    /** Exposed as blockCnt() to Python
+     */
+    uint64_t blockCnt() const;
+
+    //! Get total time acceptFrame() spent blocked in backpressure mode, in nanoseconds
+    /** Exposed as blockTime() to Python
+     */
+    uint64_t blockTime() const;
+
+    //! Get the thread set of the transmission thread
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     // Receive frame from Master
     void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    // Receive a batch of frames from Master
+    void acceptFrames(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
 };
 
 //! Alias for using shared pointer as FifoPtr
@@ -64,6 +64,9 @@ class Frame : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Fram
     // Channel
     uint8_t chan_;
 
+    // Ingress timestamp, monotonic nanoseconds, zero if not set
+    uint64_t timestamp_;
+
     // List of buffers which hold real data
     std::vector<std::shared_ptr<rogue::interfaces::stream::Buffer> > buffers_;
 
@@ -79,6 +82,11 @@ class Frame : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Fram
     // Size values dirty flags
     bool sizeDirty_;
 
+    // Deleter which recycles the Frame instead of destroying it
+    struct Recycle {
+        void operator()(rogue::interfaces::stream::Frame* frame) const;
+    };
+
   protected:
     // Set size values dirty
     void setSizeDirty();
@@ -98,6 +106,17 @@ class Frame : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Fram
      */
     static std::shared_ptr<rogue::interfaces::stream::Frame> create();
 
+    //! Get heap allocation count for Frame and Buffer objects
+    /** Frame, Buffer and FrameLock objects, along with their shared pointer control
+     * blocks, are recycled through per thread free lists once released. This returns
+     * the number of these objects which had to be allocated from the heap. Once a
+     * stream reaches steady state this count stops increasing.
+     *
+     * Exposed as getHeapAllocCount() to Python
+     * @return Number of heap allocations
+     */
+    static uint64_t getHeapAllocCount();
+
     // Create an empty Frame., not called directly.
     Frame();
 
@@ -121,6 +140,21 @@ class Frame : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Fram
     std::vector<std::shared_ptr<rogue::interfaces::stream::Buffer> >::iterator appendFrame(
         std::shared_ptr<rogue::interfaces::stream::Frame> frame);
 
+    //! Create a frame which is a view of a byte range of this frame
+    /** The returned Frame holds view buffers which reference the payload of this
+     * Frame's buffers without copying, see Buffer::createView(). The original memory
+     * is returned to its Pool, or DMA driver, once this Frame and all slices have been
+     * released. Data written to a slice is visible in this Frame and in any overlapping
+     * slice. The error, channel and timestamp fields are copied to the new Frame. A frame lock
+     * should be held when this method is called.
+     *
+     * Exposed as slice() to Python
+     * @param offset Start of the slice relative to the start of the payload
+     * @param size Size of the slice in bytes
+     * @return New Frame pointer (FramePtr)
+     */
+    std::shared_ptr<rogue::interfaces::stream::Frame> slice(uint32_t offset, uint32_t size);
+
     //! Add a buffer to end of frame,
     /** Not exposed to Python
      * This is for advanced manipulation of the underlying buffers.
@@ -293,6 +327,27 @@ class Frame : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Fram
      */
     void setError(uint8_t error);
 
+    //! Get ingress timestamp
+    /** The timestamp is set by stream sources such as the DMA, UDP, TCP and file reader
+     * interfaces when the Frame enters Rogue. It is used to measure latency through a
+     * stream chain, see Master::setTracing().
+     *
+     * Exposed as getTimestamp() to Python
+     * @return Monotonic time in nanoseconds, zero if the Frame was not stamped
+     */
+    uint64_t getTimestamp();
+
+    //! Set ingress timestamp
+    /** Exposed as setTimestamp() to Python
+     * @param timestamp Monotonic time in nanoseconds, see rogue::monotonicNs()
+     */
+    void setTimestamp(uint64_t timestamp);
+
+    //! Set ingress timestamp to the current time
+    /** Exposed as stamp() to Python
+     */
+    void stamp();
+
     //! Get begin FrameIterator
     /** Return an iterator for accessing data within the Frame.
      * This iterator assumes the payload size of the frame has
@@ -374,6 +429,21 @@ class Frame : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Fram
      */
     boost::python::object getNumpy(uint32_t offset, uint32_t count, boost::python::object dtype);
 
+    //! Python Frame data access using numpy arrays which reference the Frame buffers
+    /** Return numpy arrays which point directly to the payload data of the Frame buffers,
+     * including DMA mapped buffers, without copying the data. A single array is returned
+     * for a Frame with one buffer. A tuple containing one array per buffer is returned for
+     * a Frame with multiple buffers. Each array keeps the Frame alive.
+     *
+     * Writes to the arrays modify the Frame data. The arrays must not be used after the
+     * buffers of the Frame have been removed or replaced.
+     *
+     * Exposed as getNumpyView() to Python
+     * @param dtype NumPy dtype of the returned arrays
+     * @return Numpy array, or tuple of numpy arrays, referencing the Frame data
+     */
+    boost::python::object getNumpyView(boost::python::object dtype);
+
     //! Python Frame data write using a numpy array as the source
     /*
      *
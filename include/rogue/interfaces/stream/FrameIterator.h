@@ -18,12 +18,16 @@
 #define __ROGUE_INTERFACES_STREAM_FRAME_ITERATOR_H__
 #include "rogue/Directives.h"
 
+#include <inttypes.h>
 #include <stdint.h>
 
 #include <cstring>
 #include <memory>
 #include <vector>
 
+#include "rogue/GeneralError.h"
+#include "rogue/MemCopy.h"
+
 namespace rogue {
 namespace interfaces {
 namespace stream {
@@ -233,17 +237,19 @@ class FrameIterator : public std::iterator<std::random_access_iterator_tag, uint
 //! Inline helper function to copy values to a frame iterator
 /** This helper function copies from the passed data pointer into the
  * Frame at the iterator position. The iterator is incremented by the copy size.
+ * Copies of rogue::MemCopyStreamSize bytes or more use non-temporal stores.
  * @param iter FrameIterator at position to copy the data to
  * @param size The number of bytes to copy
  * @param src Pointer to data source
  */
 static inline void toFrame(rogue::interfaces::stream::FrameIterator& iter, uint32_t size, void* src) {
     uint8_t* ptr = reinterpret_cast<uint8_t*>(src);
+    bool stream  = (size >= rogue::MemCopyStreamSize);
     uint32_t csize;
 
     do {
         csize = (size > iter.remBuffer()) ? iter.remBuffer() : size;
-        std::memcpy(iter.ptr(), ptr, csize);
+        rogue::memCopy(iter.ptr(), ptr, csize, stream);
         ptr += csize;
         iter += csize;
         size -= csize;
@@ -253,27 +259,93 @@ static inline void toFrame(rogue::interfaces::stream::FrameIterator& iter, uint3
 //! Inline helper function to copy values from a frame iterator
 /** This helper function copies data Frame at the iterator location
  * into the passed data pointer. The iterator is updated by byte copy size.
+ * Copies of rogue::MemCopyStreamSize bytes or more use non-temporal stores.
  * @param iter FrameIterator at position to copy the data from
  * @param size The number of bytes to copy
  * @param dst Pointer to data destination
  */
 static inline void fromFrame(rogue::interfaces::stream::FrameIterator& iter, uint32_t size, void* dst) {
     uint8_t* ptr = reinterpret_cast<uint8_t*>(dst);
+    bool stream  = (size >= rogue::MemCopyStreamSize);
     uint32_t csize;
 
     do {
         csize = (size > iter.remBuffer()) ? iter.remBuffer() : size;
-        std::memcpy(ptr, iter.ptr(), csize);
+        rogue::memCopy(ptr, iter.ptr(), csize, stream);
         ptr += csize;
         iter += csize;
         size -= csize;
     } while (size > 0 && csize > 0);
 }
 
+//! Largest word size supported by forEachSpan()
+const uint32_t MaxSpanWord = 64;
+
+//! Inline helper function to visit the contiguous data spans of a frame
+/** This helper function calls the passed function once for each contiguous block of
+ * memory in the range of size bytes starting at the iterator position, so that parsers
+ * and checkers can work on plain pointers without the Buffer boundary checks done by
+ * each FrameIterator increment. The iterator is incremented past each visited span.
+ *
+ * The function is called as func(uint8_t *data, uint32_t len) and returns true to
+ * continue or false to stop after the current span.
+ *
+ * With a word size above 1 the length of each span is a multiple of the word size, so
+ * that words can be processed without checking for a partial word. A word which crosses
+ * a Buffer boundary is copied into a temporary and passed as a span of its own, so word
+ * aligned spans are intended for reading. Only a final partial word, when size is not a
+ * multiple of the word size, is passed with a shorter length.
+ * @param iter FrameIterator at the start of the range
+ * @param size The number of bytes to visit, must not extend past the end of the frame
+ * @param word Word size in bytes, 1 - MaxSpanWord
+ * @param func Function to call for each span
+ * @return Number of bytes visited
+ */
+template <typename F>
+static inline uint32_t forEachSpan(rogue::interfaces::stream::FrameIterator& iter,
+                                   uint32_t size,
+                                   uint32_t word,
+                                   F func) {
+    uint8_t temp[MaxSpanWord];
+    uint32_t total;
+    uint32_t csize;
+    bool more;
+
+    if (word == 0 || word > MaxSpanWord)
+        throw(rogue::GeneralError::create("forEachSpan",
+                                          "Invalid word size %" PRIu32 ", must be 1 - %" PRIu32,
+                                          word,
+                                          MaxSpanWord));
+
+    total = 0;
+    more  = true;
+
+    while (more && size > 0 && iter.remBuffer() > 0) {
+        csize = (size > iter.remBuffer()) ? iter.remBuffer() : size;
+        csize -= csize % word;
+
+        // Whole words in the current buffer
+        if (csize > 0) {
+            more = func(iter.ptr(), csize);
+            iter += csize;
+
+            // Word crosses a buffer boundary
+        } else {
+            csize = (size > word) ? word : size;
+            fromFrame(iter, csize, temp);
+            more = func(temp, csize);
+        }
+        size -= csize;
+        total += csize;
+    }
+    return total;
+}
+
 //! Inline helper function to copy frame data between frames
 /** This helper function copies data from the source Frame at the iterator
  * location into the dest frame at the iterator location. Both iterators are
- * updated by byte copy size.
+ * updated by byte copy size. Copies of rogue::MemCopyStreamSize bytes or more
+ * use non-temporal stores so that copying a large frame does not flush the cache.
  * @param srcIter FrameIterator at position to copy the data from
  * @param size The number of bytes to copy
  * @param dstIter FrameIterator at position to copy the data to
@@ -281,12 +353,14 @@ static inline void fromFrame(rogue::interfaces::stream::FrameIterator& iter, uin
 static inline void copyFrame(rogue::interfaces::stream::FrameIterator& srcIter,
                              uint32_t size,
                              rogue::interfaces::stream::FrameIterator& dstIter) {
+    bool stream = (size >= rogue::MemCopyStreamSize);
     uint32_t csize;
 
+    // Each copy is bounded by both buffers, so the iterators always advance together
     do {
         csize = (size > srcIter.remBuffer()) ? srcIter.remBuffer() : size;
         csize = (csize > dstIter.remBuffer()) ? dstIter.remBuffer() : csize;
-        std::memcpy(dstIter.ptr(), srcIter.ptr(), csize);
+        rogue::memCopy(dstIter.ptr(), srcIter.ptr(), csize, stream);
         srcIter += csize;
         dstIter += csize;
         size -= csize;
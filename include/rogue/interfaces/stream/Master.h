@@ -20,6 +20,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <cstdio>
 #include <memory>
 #include <mutex>
@@ -28,6 +29,7 @@
 #include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
+#include "rogue/Histogram.h"
 
 #ifndef NO_PYTHON
     #include <boost/python.hpp>
@@ -39,21 +41,51 @@ namespace stream {
 
 class Slave;
 class Frame;
+class Pool;
 
 //! Stream master class
 /** This class serves as the source for sending Frame data to a Slave. Each master
  * interfaces to one or more stream slave objects. The first stream Slave is used
  * to allocated new Frame objects and it is the last Slave to receive frame data.
+ *
+ * The list of slaves is published as an immutable snapshot which is replaced when
+ * a slave is added. Sending a frame reads the current snapshot without locking,
+ * copying or touching the slave reference counts.
+ *
+ * When tracing is enabled the Master records the age of each timestamped Frame,
+ * see Frame::getTimestamp(), into a latency histogram for each attached Slave as
+ * the Frame is passed to it. Comparing the histograms of consecutive stages shows
+ * where latency builds up in a stream chain. When tracing is disabled the cost is
+ * a single pointer check per sendFrame() call.
  */
 class Master : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Master> {
-    // Vector of slaves
-    std::vector<std::shared_ptr<rogue::interfaces::stream::Slave> > slaves_;
+    typedef std::vector<std::shared_ptr<rogue::interfaces::stream::Slave> > SlaveList;
 
-    // Slave mutex
+    // Current slave list snapshot
+    std::atomic<const SlaveList*> slaves_;
+
+    // All published snapshots, kept until the master is destroyed so that readers never see a freed list
+    std::vector<std::shared_ptr<const SlaveList> > slaveHist_;
+
+    // Slave mutex, serializes snapshot updates
     std::mutex slaveMtx_;
 
-    // Default slave if not connected
-    std::shared_ptr<rogue::interfaces::stream::Slave> defSlave_;
+    // Default frame pool if not connected, a plain Pool so that it publishes no metrics
+    std::shared_ptr<rogue::interfaces::stream::Pool> defSlave_;
+
+    typedef std::vector<std::shared_ptr<rogue::Histogram> > LatencyList;
+
+    // Current latency histogram snapshot, one per slave, NULL when tracing is disabled
+    std::atomic<const LatencyList*> latency_;
+
+    // All published latency snapshots, kept for the same reason as slaveHist_
+    std::vector<std::shared_ptr<const LatencyList> > latencyHist_;
+
+    // Latency histograms, kept when tracing is disabled
+    LatencyList latencyAll_;
+
+    // Publish latency snapshot, called with slaveMtx_ held
+    void publishLatency();
 
   public:
     //! Class factory which returns a pointer to a Master object (MasterPtr)
@@ -117,6 +149,18 @@ class Master : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Mas
      */
     void sendFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
 
+    //! Push a batch of frames to all slaves
+    /** This method sends the passed list of Frame objects to all of the attached Slave
+     * objects by calling their acceptFrames() method, in the same Slave order as
+     * sendFrame(). Each Slave receives the whole batch in order before the next Slave
+     * is called. Slaves which do not implement acceptFrames() receive the frames one
+     * at a time through acceptFrame().
+     *
+     * Not exposed to Python
+     * @param frames List of Frame pointers (FramePtr) to send, must not be modified by the slaves
+     */
+    void sendFrames(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
+
     //! Ensure frame is a single buffer
     /** This method makes sure the passed frame is composed of a single buffer.
      *  If the reqNew flag is true and the passed frame is not a single buffer, a
@@ -140,6 +184,30 @@ class Master : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Mas
      */
     virtual void stop();
 
+    //! Enable or disable latency tracing
+    /** When enabled, a latency histogram is kept for each attached Slave. Each time a
+     * Frame with a non-zero timestamp is sent, the time since the Frame timestamp is
+     * recorded in nanoseconds in the histogram of each Slave before it receives the Frame.
+     * Histograms are kept when tracing is disabled and resume when it is re-enabled.
+     *
+     * Exposed as setTracing() to Python
+     * @param enable Tracing enable flag
+     */
+    void setTracing(bool enable);
+
+    //! Get latency tracing state
+    /** Exposed as getTracing() to Python
+     * @return True if tracing is enabled
+     */
+    bool getTracing();
+
+    //! Get latency histogram for a slave
+    /** Exposed as getLatency() to Python
+     * @param index Slave index, in order of attachment
+     * @return Latency histogram as a HistogramPtr
+     */
+    std::shared_ptr<rogue::Histogram> getLatency(uint32_t index);
+
 #ifndef NO_PYTHON
 
     //! Support == operator in python
@@ -0,0 +1,207 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Stream Frame FIFO with parallel workers and ordered output
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_STREAM_PARALLEL_FIFO_H__
+#define __ROGUE_INTERFACES_STREAM_PARALLEL_FIFO_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/RingQueue.h"
+#include "rogue/Threads.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace rogue {
+namespace interfaces {
+namespace stream {
+
+//! Ordered output port of a ParallelFifo
+/** Frames sent to this Slave by a worker stage attached to a ParallelFifo are forwarded
+ * to the attached Slave objects. When ordering is enabled, frames are held in a
+ * reorder buffer so that they are forwarded in the order in which the ParallelFifo
+ * received the input frames that produced them. An input frame may produce any number
+ * of output frames, including none.
+ *
+ * Frames received from a thread which is not a worker thread of the owning ParallelFifo
+ * are forwarded immediately.
+ *
+ * This object is created by the ParallelFifo and returned by ParallelFifo::output().
+ */
+class ParallelFifoOutput : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
+    friend class ParallelFifo;
+
+    // Frames produced for an input frame which is not yet at the head of the order
+    struct Slot {
+        bool done;
+        std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> > frames;
+
+        Slot() : done(false) {}
+    };
+
+    // Ordering enable
+    bool ordered_;
+
+    // Reorder state
+    std::mutex mtx_;
+    uint64_t nextSeq_;
+    std::map<uint64_t, Slot> pending_;
+
+    // Mark processing of the passed sequence number complete, called by worker threads
+    void done(uint64_t seq);
+
+  public:
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create the output port
+    explicit ParallelFifoOutput(bool ordered);
+
+    // Destroy the output port
+    ~ParallelFifoOutput();
+
+    // Accept a frame from the worker stage
+    void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    //! Get reorder buffer depth
+    /** Return the number of input frames whose output is being held in the reorder buffer.
+     *
+     * Exposed as pending() to Python
+     * @return Number of held input frames
+     */
+    uint32_t pending();
+};
+
+//! Alias for using shared pointer as ParallelFifoOutputPtr
+typedef std::shared_ptr<rogue::interfaces::stream::ParallelFifoOutput> ParallelFifoOutputPtr;
+
+//! Stream Frame FIFO with parallel workers
+/** The ParallelFifo buffers Frame data as it is received from a Master and passes
+ * it to the attached Slave objects from a pool of worker threads, so that a CPU heavy
+ * processing stage can use more than one core. The attached Slave objects are called
+ * concurrently from all worker threads and must be thread safe.
+ *
+ * When the processing stage produces output frames, it is connected to the output()
+ * port, which forwards the frames downstream. With ordering enabled the output port
+ * restores the order in which frames were received by the ParallelFifo:
+ *
+ * src >> parallelFifo >> worker >> parallelFifo.output() >> sink
+ *
+ * Frames are passed to the workers without a copy. The ParallelFifo supports a maximum
+ * depth to be configured, after which new incoming Frame objects are dropped.
+ */
+class ParallelFifo : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
+    // Queue entry, input frame and its order
+    struct Work {
+        uint64_t seq;
+        std::shared_ptr<rogue::interfaces::stream::Frame> frame;
+    };
+
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Configurations
+    uint32_t maxDepth_;
+
+    // Drop frame counter
+    std::shared_ptr<rogue::Counter> dropFrameCnt_;
+
+    // Next input sequence number
+    std::atomic<uint64_t> seq_;
+
+    // Queue
+    rogue::RingQueue<Work> queue_;
+
+    // Ordered output
+    std::shared_ptr<rogue::interfaces::stream::ParallelFifoOutput> output_;
+
+    // Worker threads
+    bool threadEn_;
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
+    std::vector<std::thread*> threads_;
+
+    // Thread background
+    void runThread();
+
+  public:
+    //! Create a ParallelFifo object and return as a ParallelFifoPtr
+    /** Exposed as rogue.interfaces.stream.ParallelFifo() to Python
+     * @param maxDepth Set to a non-zero value to drop frames above this depth.
+     * @param threads Number of worker threads.
+     * @param ordered Set to true to restore the input order at the output port.
+     * @return ParallelFifo object as a ParallelFifoPtr
+     */
+    static std::shared_ptr<rogue::interfaces::stream::ParallelFifo> create(uint32_t maxDepth,
+                                                                           uint32_t threads,
+                                                                           bool ordered);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a ParallelFifo object.
+    ParallelFifo(uint32_t maxDepth, uint32_t threads, bool ordered);
+
+    // Destroy the ParallelFifo
+    ~ParallelFifo();
+
+    //! Get output port
+    /** Return the port to which the worker stage sends its output frames.
+     *
+     * Exposed as output() to Python
+     * @return Output port as a ParallelFifoOutputPtr
+     */
+    std::shared_ptr<rogue::interfaces::stream::ParallelFifoOutput> output();
+
+    //! Get queue depth
+    /** Exposed as size() to Python
+     * @return Number of frames waiting for a worker
+     */
+    std::size_t size();
+
+    //! Get drop count
+    /** Exposed as dropCnt() to Python
+     * @return Number of frames dropped because the maximum depth was reached
+     */
+    std::size_t dropCnt() const;
+
+    //! Clear drop counter
+    /** Exposed as clearCnt() to Python
+     */
+    void clearCnt();
+
+    //! Get the thread set of the worker threads
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
+    // Receive frame from Master
+    void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+};
+
+//! Alias for using shared pointer as ParallelFifoPtr
+typedef std::shared_ptr<rogue::interfaces::stream::ParallelFifo> ParallelFifoPtr;
+}  // namespace stream
+}  // namespace interfaces
+}  // namespace rogue
+#endif
@@ -20,11 +20,15 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
+#include "rogue/Metrics.h"
 #include "rogue/Queue.h"
 
 namespace rogue {
@@ -46,30 +50,77 @@ class Buffer;
  * a new requester. The pool size defines the maximum number of entries to allow in
  * the pool.
  *
+ * When the pool is enabled each thread keeps a small cache (magazine) of free buffers
+ * in front of the shared pool. Buffers are allocated from and returned to the calling
+ * thread's cache without locking, and the shared pool is only accessed to refill an
+ * empty cache or drain a full one.
+ *
+ * In fixed size mode the buffers can optionally be carved out of a single pre-faulted
+ * memory arena, see setArena(). Arena buffers are always returned to the pool and are
+ * only released when the Pool is destroyed.
+ *
  * A subclass can be created with intercepts the Frame requests and allocates
  * Frame and Buffer objects from an alternative source such as a hardware DMA driver.
  */
 class Pool : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Pool> {
+    // Per thread buffer cache, defined in Pool.cpp
+    struct ThreadCache;
+    friend struct ThreadCache;
+    static thread_local ThreadCache threadCache_;
+
+    // Buffer arena, defined in Pool.cpp
+    struct Arena;
+
     // Mutex
     std::mutex mtx_;
 
+    // Unique pool id used to key thread caches
+    std::atomic<uint64_t> poolId_;
+
+    // Buffer arena, arenaHold_ owns the region and is shared with the thread caches
+    std::shared_ptr<Arena> arenaHold_;
+    std::atomic<Arena*> arena_;
+
     // Track buffer allocations
-    uint32_t allocMeta_;
+    std::atomic<uint32_t> allocMeta_;
 
     // Total memory allocated
-    uint32_t allocBytes_;
+    std::shared_ptr<rogue::Gauge> allocBytes_;
 
     // Total buffers allocated
-    uint32_t allocCount_;
+    std::shared_ptr<rogue::Gauge> allocCount_;
 
     // Buffer queue
     std::queue<uint8_t*> dataQ_;
 
+    // Free buffers held in the buffer queue and thread caches
+    std::atomic<uint32_t> freeCount_;
+
     // Fixed size buffer mode
-    uint32_t fixedSize_;
+    std::atomic<uint32_t> fixedSize_;
 
     // Buffer queue count
-    uint32_t poolSize_;
+    std::atomic<uint32_t> poolSize_;
+
+    // Thread cache depth
+    std::atomic<uint32_t> cacheDepth_;
+
+    // Number of thread cache refills and drains which used the buffer queue
+    std::shared_ptr<rogue::Counter> cacheMiss_;
+
+    // Metrics set passed to addPoolMetrics(), the metrics are registered by the first allocation
+    std::shared_ptr<rogue::MetricSet> poolMetrics_;
+    std::atomic<bool> poolMetricsPend_;
+
+    // Register the allocation metrics on first use
+    void publishPoolMetrics();
+
+    // Get the calling thread's cache for this pool, NULL if caching is disabled
+    std::vector<uint8_t*>* localCache();
+
+    // Move buffers between a thread cache and the buffer queue
+    void cacheRefill(std::vector<uint8_t*>* cache);
+    void cacheDrain(std::vector<uint8_t*>* cache, uint32_t keep);
 
   public:
     // Class creator
@@ -152,6 +203,63 @@ class Pool : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Pool>
      */
     uint32_t getPoolSize();
 
+    //! Set thread cache depth
+    /** Set the maximum number of free buffers each thread keeps in its local
+     * cache. The cache is only used when the pool is enabled in fixed size mode.
+     * A depth of zero disables the thread caches.
+     *
+     * Exposed as setCacheDepth() to Python
+     * @param depth Number of buffers to keep in each thread cache
+     */
+    void setCacheDepth(uint32_t depth);
+
+    //! Get thread cache depth
+    /** Return configured thread cache depth
+     *
+     * Exposed as getCacheDepth() to Python
+     * @return Thread cache depth
+     */
+    uint32_t getCacheDepth();
+
+    //! Get thread cache miss count
+    /** Return the number of times a thread cache was refilled from or drained to
+     * the shared pool, each of which requires taking the pool lock.
+     *
+     * Exposed as getCacheMissCount() to Python
+     * @return Thread cache miss count
+     */
+    uint64_t getCacheMissCount();
+
+    //! Allocate a buffer arena
+    /** Pre-allocate the pool buffers out of a single memory region. The region
+     * is mapped with huge pages when requested and supported, bound to the passed
+     * NUMA node, and every page is touched up front so that no page faults are taken
+     * once data is flowing. The region is divided into buffers of the configured
+     * fixed size, which are placed in the pool and are never freed until the Pool
+     * is destroyed. If the arena runs empty further buffers are allocated with malloc
+     * as before.
+     *
+     * Fixed size mode must be enabled first and the arena can only be set once. This
+     * should be called before the pool is used. If huge pages, NUMA binding or memory
+     * locking are not available a warning is logged and the arena is created without
+     * them.
+     *
+     * Exposed as setArena() to Python
+     * @param size Arena size in bytes
+     * @param hugePages Set to true to map the arena with huge pages
+     * @param numaNode NUMA node to bind the arena to, -1 for no binding
+     * @param lock Set to true to lock the arena in memory
+     */
+    void setArena(uint64_t size, bool hugePages, int32_t numaNode, bool lock);
+
+    //! Get arena size
+    /** Return the number of buffers in the arena
+     *
+     * Exposed as getArenaSize() to Python
+     * @return Number of arena buffers, 0 if no arena is configured
+     */
+    uint32_t getArenaSize();
+
   protected:
     //! Allocate and Create a Buffer
     /** This method is the default Buffer allocator. The requested
@@ -194,6 +302,16 @@ class Pool : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Pool>
      * @param alloc Amount of memory be de-allocated.
      */
     void decCounter(uint32_t alloc);
+
+    //! Register the allocation metrics
+    /** Adds allocBytes, allocCount and cacheMiss to the passed MetricSet. The metrics
+     * are registered when the first buffer is allocated, so objects which never serve
+     * frame requests do not publish them.
+     *
+     * Not exposed to Python
+     * @param metrics MetricSet of the owning object
+     */
+    void addPoolMetrics(std::shared_ptr<rogue::MetricSet> metrics);
 };
 
 //! Alias for using shared pointer as PoolPtr
@@ -0,0 +1,177 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Stream Frame FIFO with per channel priority scheduling
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_STREAM_PRIORITY_FIFO_H__
+#define __ROGUE_INTERFACES_STREAM_PRIORITY_FIFO_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace rogue {
+namespace interfaces {
+namespace stream {
+
+//! Stream Frame FIFO with priority scheduling
+/** The PriorityFifo buffers Frame data as it is received from a Master and passes
+ * it to the attached Slave objects in an independent thread, like the Fifo. Incoming
+ * frames are sorted into a number of classes by their channel, see Frame::getChannel(),
+ * each class having its own queue. This prevents a burst of large frames on one
+ * channel from delaying the frames of a latency critical channel.
+ *
+ * Classes are numbered from zero. All channels are initially mapped to the last class,
+ * use setChannel() to map a channel to another class. The queues are served in one of
+ * two modes:
+ *
+ * Strict priority: the lowest numbered class with a queued frame is always served
+ * first. A busy high priority class can starve the lower priority classes.
+ *
+ * Weighted fair: the classes are served round robin, each class receiving a share
+ * of the output bandwidth in bytes which is proportional to its weight, using deficit
+ * round robin scheduling.
+ *
+ * Each class has its own maximum depth, after which new incoming frames for that class
+ * are dropped and counted. Frames are queued without a copy.
+ */
+class PriorityFifo : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
+    // Queue entry, payload size is recorded for the scheduler
+    struct Entry {
+        std::shared_ptr<rogue::interfaces::stream::Frame> frame;
+        uint32_t size;
+    };
+
+    // Per class state, protected by mtx_
+    struct Class {
+        std::deque<Entry> queue;
+        uint32_t maxDepth;
+        uint32_t weight;
+        uint64_t deficit;
+        std::shared_ptr<rogue::Counter> dropCnt;
+        std::shared_ptr<rogue::Gauge> depth;
+    };
+
+    // Bytes added to the deficit of a class per unit of weight in each round
+    static const uint32_t Quantum = 4096;
+
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Scheduling mode
+    bool weighted_;
+
+    // Channel to class map
+    uint32_t chanMap_[256];
+
+    // Classes and scheduler state
+    std::vector<Class> classes_;
+    uint32_t count_;
+
+    // Weighted fair state, class being served and whether it received its quantum this round
+    uint32_t next_;
+    bool granted_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+
+    // Transmission thread
+    bool threadEn_;
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
+    std::thread* thread_;
+
+    // Select the next entry to send, called with mtx_ held and count_ non-zero
+    Entry pop();
+
+    // Thread background
+    void runThread();
+
+  public:
+    //! Create a PriorityFifo object and return as a PriorityFifoPtr
+    /** Exposed as rogue.interfaces.stream.PriorityFifo() to Python
+     * @param classes Number of classes, 1 - 256
+     * @param weighted Set to true for weighted fair scheduling, false for strict priority
+     * @return PriorityFifo object as a PriorityFifoPtr
+     */
+    static std::shared_ptr<rogue::interfaces::stream::PriorityFifo> create(uint32_t classes, bool weighted);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a PriorityFifo object.
+    PriorityFifo(uint32_t classes, bool weighted);
+
+    // Destroy the PriorityFifo
+    ~PriorityFifo();
+
+    //! Map a channel to a class
+    /** Exposed as setChannel() to Python
+     * @param channel Frame channel
+     * @param cls Class number, zero is the highest priority
+     */
+    void setChannel(uint8_t channel, uint32_t cls);
+
+    //! Configure a class
+    /** Exposed as setClass() to Python
+     * @param cls Class number
+     * @param maxDepth Set to a non-zero value to drop frames for this class above this depth
+     * @param weight Relative share of the output bandwidth in weighted fair mode, at least 1
+     */
+    void setClass(uint32_t cls, uint32_t maxDepth, uint32_t weight);
+
+    //! Get queue depth of a class
+    /** Exposed as size() to Python
+     * @param cls Class number
+     * @return Number of frames queued for the class
+     */
+    std::size_t size(uint32_t cls);
+
+    //! Get drop count of a class
+    /** Exposed as dropCnt() to Python
+     * @param cls Class number
+     * @return Number of frames dropped because the maximum depth of the class was reached
+     */
+    std::size_t dropCnt(uint32_t cls);
+
+    //! Clear drop counters
+    /** Exposed as clearCnt() to Python
+     */
+    void clearCnt();
+
+    //! Get the thread set of the transmission thread
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
+    // Receive frame from Master
+    void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+};
+
+//! Alias for using shared pointer as PriorityFifoPtr
+typedef std::shared_ptr<rogue::interfaces::stream::PriorityFifo> PriorityFifoPtr;
+}  // namespace stream
+}  // namespace interfaces
+}  // namespace rogue
+#endif
@@ -20,12 +20,15 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
 #include "rogue/Logging.h"
+#include "rogue/Metrics.h"
 #include "rogue/interfaces/stream/Pool.h"
 
 #ifndef NO_PYTHON
@@ -55,8 +58,15 @@ class Slave : public rogue::interfaces::stream::Pool,
     std::shared_ptr<rogue::Logging> log_;
 
     // Counters
-    uint64_t frameCount_;
-    uint64_t frameBytes_;
+    std::shared_ptr<rogue::Counter> frameCount_;
+    std::shared_ptr<rogue::Counter> frameBytes_;
+
+    // Frame counters are registered by the first frame passed to the base acceptFrame()
+    std::atomic<bool> frameMetricsPend_;
+
+  protected:
+    //! Metrics of this object, sub-classes set their own prefix and add their metrics
+    std::shared_ptr<rogue::MetricSet> metrics_;
 
   public:
     //! Class factory which returns a pointer to a Slave (SlavePtr)
@@ -105,6 +115,17 @@ class Slave : public rogue::interfaces::stream::Pool,
      */
     virtual void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
 
+    //! Accept a batch of frames from master
+    /** This method is called by the Master object to which this Slave is attached when
+     * passing a batch of Frame objects with sendFrames(). By default each frame is passed
+     * to acceptFrame() in order. A sub-class can re-implement this method to amortize
+     * locking and dispatch costs over the batch. The passed list must not be modified.
+     *
+     * Not exposed to Python
+     * @param frames List of Frame pointers (FramePtr)
+     */
+    virtual void acceptFrames(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
+
     //! Get frame counter
     /** Returns the total frames received. Only valid if acceptFrame is not re-implemented
      * as a sub-class. Typically used when attaching a base Slave object for debug purposes.
@@ -123,6 +144,22 @@ class Slave : public rogue::interfaces::stream::Pool,
      */
     uint64_t getByteCount();
 
+    //! Set metrics path
+    /** Set the path under which the metrics of this object are registered in the
+     * rogue::Metrics registry, typically the path of the owning pyrogue Device.
+     * The default path is the class name followed by an instance index.
+     *
+     * Exposed as setMetricsPath() to Python
+     * @param path New path
+     */
+    void setMetricsPath(const std::string& path);
+
+    //! Get metrics path
+    /** Exposed as getMetricsPath() to Python
+     * @return Path of the metrics of this object
+     */
+    std::string getMetricsPath();
+
     //! Ensure frame is a single buffer
     /** This method makes sure the passed frame is composed of a single buffer.
      *  If the reqNew flag is true and the passed frame is not a single buffer, a
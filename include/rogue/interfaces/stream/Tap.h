@@ -0,0 +1,116 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Lossy stream monitoring tap
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_STREAM_TAP_H__
+#define __ROGUE_INTERFACES_STREAM_TAP_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace rogue {
+namespace interfaces {
+namespace stream {
+
+//! Lossy stream monitoring tap
+/** The Tap attaches slow monitors, such as a Python receiver or a display, to a high
+ * rate stream without slowing down the stream. It is connected to the source next to
+ * the primary Slave, and the monitors are connected to the Tap.
+ *
+ * The Tap holds a single frame. Each received frame replaces the held frame and is
+ * forwarded to the monitors in an independent thread once the monitors have finished
+ * with the previous frame, so the monitors always receive the latest frame. Frames
+ * which are replaced before they are forwarded are counted as skipped. Receiving a
+ * frame never waits for the monitors.
+ *
+ * Frames are forwarded without a copy and are shared with the primary path, so the
+ * monitors must not modify them.
+ */
+class Tap : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Held frame, protected by mtx_
+    std::shared_ptr<rogue::interfaces::stream::Frame> slot_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+
+    std::shared_ptr<rogue::Counter> skipCnt_;
+
+    // Transmission thread
+    bool threadEn_;
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
+    std::thread* thread_;
+
+    // Thread background
+    void runThread();
+
+  public:
+    //! Create a Tap object and return as a TapPtr
+    /** Exposed as rogue.interfaces.stream.Tap() to Python
+     * @return Tap object as a TapPtr
+     */
+    static std::shared_ptr<rogue::interfaces::stream::Tap> create();
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a Tap object.
+    Tap();
+
+    // Destroy the Tap
+    ~Tap();
+
+    //! Get the number of skipped frames
+    /** Exposed as skipCnt() to Python
+     * @return Number of frames replaced before they were forwarded
+     */
+    uint64_t skipCnt();
+
+    //! Clear skip counter
+    /** Exposed as clearCnt() to Python
+     */
+    void clearCnt();
+
+    //! Get the thread set of the transmission thread
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
+    // Receive frame from Master
+    void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    // Receive a batch of frames from Master
+    void acceptFrames(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames);
+};
+
+//! Alias for using shared pointer as TapPtr
+typedef std::shared_ptr<rogue::interfaces::stream::Tap> TapPtr;
+}  // namespace stream
+}  // namespace interfaces
+}  // namespace rogue
+#endif
@@ -25,6 +25,7 @@
 #include <thread>
 
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
@@ -69,6 +70,7 @@ class TcpCore : public rogue::interfaces::stream::Master, public rogue::interfac
     std::shared_ptr<rogue::Logging> bridgeLog_;
 
     // Thread
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
 
@@ -108,6 +110,11 @@ class TcpCore : public rogue::interfaces::stream::Master, public rogue::interfac
     // Stop  the interface
     void stop();
 
+    //! Get the thread set of the receive thread
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     // Receive frame from Master
     void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
 };
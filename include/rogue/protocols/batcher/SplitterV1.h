@@ -31,7 +31,11 @@ namespace rogue {
 namespace protocols {
 namespace batcher {
 
-//!  AXI Stream FIFO
+//!  Batcher splitter, version 1
+/** Splits each received batcher frame into one frame per record. The record frames
+ * are zero copy slices of the received frame, see Frame::slice(), so the received
+ * buffers are held until all records from the batch have been released.
+ */
 class SplitterV1 : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
   public:
     //! Class creation
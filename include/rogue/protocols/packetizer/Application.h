@@ -22,7 +22,7 @@
 
 #include <memory>
 
-#include "rogue/Queue.h"
+#include "rogue/RingQueue.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -48,7 +48,7 @@ class Application : public rogue::interfaces::stream::Master, public rogue::inte
     void runThread();
 
     // Application queue
-    rogue::Queue<std::shared_ptr<rogue::interfaces::stream::Frame>> queue_;
+    rogue::RingQueue<std::shared_ptr<rogue::interfaces::stream::Frame>> queue_;
 
   public:
     //! Class creation
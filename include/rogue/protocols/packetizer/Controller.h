@@ -23,7 +23,9 @@
 #include <memory>
 
 #include "rogue/Logging.h"
-#include "rogue/Queue.h"
+#include "rogue/Metrics.h"
+#include "rogue/RingQueue.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -46,7 +48,7 @@ class Controller {
     uint32_t tranCount_[256];
     uint32_t crc_[256];
     uint8_t tranDest_;
-    uint32_t dropCount_;
+    std::shared_ptr<rogue::Counter> dropCount_;
     uint32_t headSize_;
     uint32_t tailSize_;
     uint32_t alignSize_;
@@ -55,6 +57,10 @@ class Controller {
 
     std::shared_ptr<rogue::Logging> log_;
 
+    std::shared_ptr<rogue::MetricSet> metrics_;
+
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
+
     std::shared_ptr<rogue::interfaces::stream::Frame> tranFrame_[256];
 
     std::mutex appMtx_;
@@ -63,7 +69,7 @@ class Controller {
     std::shared_ptr<rogue::protocols::packetizer::Transport> tran_;
     std::shared_ptr<rogue::protocols::packetizer::Application>* app_;
 
-    rogue::Queue<std::shared_ptr<rogue::interfaces::stream::Frame>> tranQueue_;
+    rogue::RingQueue<std::shared_ptr<rogue::interfaces::stream::Frame>> tranQueue_;
 
   public:
     //! Creator
@@ -100,6 +106,9 @@ class Controller {
 
     //! Set timeout in microseconds for frame transmits
     void setTimeout(uint32_t timeout);
+
+    //! Get the thread set of the transport and application threads
+    std::shared_ptr<rogue::ThreadSet> threads();
 };
 
 // Convenience
@@ -23,6 +23,8 @@
 #include <memory>
 #include <thread>
 
+#include "rogue/Threads.h"
+
 namespace rogue {
 namespace protocols {
 namespace packetizer {
@@ -66,6 +68,9 @@ class Core {
 
     //! Set timeout
     void setTimeout(uint32_t timeout);
+
+    //! Get the thread set of the transport and application threads
+    std::shared_ptr<rogue::ThreadSet> threads();
 };
 
 // Convenience
@@ -23,6 +23,8 @@
 #include <memory>
 #include <thread>
 
+#include "rogue/Threads.h"
+
 namespace rogue {
 namespace protocols {
 namespace rssi {
@@ -122,6 +124,11 @@ class Client {
     //! Set timeout in microseconds for frame transmits
     void setTimeout(uint32_t timeout);
 
+    //! Get the thread set of the state and application threads
+    /** Exposed as threads() to Python
+     */
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     //! Stop connection
     void stop();
 
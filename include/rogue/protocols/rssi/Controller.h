@@ -25,7 +25,9 @@
 
 #include "rogue/EnableSharedFromThis.h"
 #include "rogue/Logging.h"
-#include "rogue/Queue.h"
+#include "rogue/Metrics.h"
+#include "rogue/RingQueue.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -73,24 +75,26 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
 
     std::shared_ptr<rogue::Logging> log_;
 
+    std::shared_ptr<rogue::MetricSet> metrics_;
+
     // Is server
     bool server_;
 
     // Receive tracking
-    uint32_t dropCount_;
+    std::shared_ptr<rogue::Counter> dropCount_;
     uint8_t nextSeqRx_;
     uint8_t lastAckRx_;
     bool remBusy_;
     bool locBusy_;
 
     // Application queue
-    rogue::Queue<std::shared_ptr<rogue::protocols::rssi::Header>> appQueue_;
+    rogue::RingQueue<std::shared_ptr<rogue::protocols::rssi::Header>> appQueue_;
 
     // Sequence Out of Order ("OOO") queue
     std::map<uint8_t, std::shared_ptr<rogue::protocols::rssi::Header>> oooQueue_;
 
     // State queue
-    rogue::Queue<std::shared_ptr<rogue::protocols::rssi::Header>> stQueue_;
+    rogue::RingQueue<std::shared_ptr<rogue::protocols::rssi::Header>> stQueue_;
 
     // Application tracking
     uint8_t lastSeqRx_;
@@ -102,7 +106,7 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     uint32_t state_;
     struct timeval stTime_;
     uint32_t downCount_;
-    uint32_t retranCount_;
+    std::shared_ptr<rogue::Counter> retranCount_;
     uint32_t locBusyCnt_;
     uint32_t remBusyCnt_;
     uint32_t locConnId_;
@@ -126,6 +130,7 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     struct timeval zeroTme_;       // 0
 
     // State thread
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
 
@@ -225,6 +230,9 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     //! Set timeout in microseconds for frame transmits
     void setTimeout(uint32_t timeout);
 
+    //! Get the thread set of the state and application threads
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     //! Stop connection
     void stop();
 
@@ -27,6 +27,8 @@
 #include <memory>
 
 #include "rogue/Logging.h"
+#include "rogue/Reactor.h"
+#include "rogue/Threads.h"
 
 namespace rogue {
 namespace protocols {
@@ -41,6 +43,9 @@ const uint32_t HdrSize = 20 + 8;
 const uint32_t MaxJumboPayload = JumboMTU - HdrSize;
 const uint32_t MaxStdPayload   = StdMTU - HdrSize;
 
+// Maximum number of received frames forwarded as a single batch
+const uint32_t RxBatchSize = 64;
+
 //! UDP Core
 class Core {
   protected:
@@ -58,9 +63,13 @@ class Core {
     //! Timeout value
     struct timeval timeout_;
 
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
 
+    //! Shared reactor, replaces the receive thread when set
+    std::shared_ptr<rogue::Reactor> reactor_;
+
     //! mutex
     std::mutex udpMtx_;
 
@@ -85,6 +94,9 @@ class Core {
 
     //! Set timeout for frame transmits in microseconds
     void setTimeout(uint32_t timeout);
+
+    //! Get the thread set of the receive thread
+    std::shared_ptr<rogue::ThreadSet> threads();
 };
 
 // Convenience
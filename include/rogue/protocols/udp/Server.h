@@ -49,6 +49,9 @@ class Server : public rogue::protocols::udp::Core,
     //! Thread background
     void runThread(std::weak_ptr<int>);
 
+    //! Receive from the reactor
+    void rxReady();
+
   public:
     //! Class creation
     static std::shared_ptr<rogue::protocols::udp::Server> create(uint16_t port, bool jumbo);
@@ -65,6 +68,15 @@ class Server : public rogue::protocols::udp::Core,
     //! Stop the interface
     void stop();
 
+    //! Receive using a shared reactor
+    /** Stops the receive thread of the server and registers the socket with the passed
+     * Reactor. The reactor is used until the interface is stopped.
+     *
+     * Exposed as setReactor() to Python
+     * @param reactor Reactor object
+     */
+    void setReactor(std::shared_ptr<rogue::Reactor> reactor);
+
     //! Get port number
     uint32_t getPort();
 
@@ -29,7 +29,8 @@
 
 #include "rogue/GeneralError.h"
 #include "rogue/Logging.h"
-#include "rogue/Queue.h"
+#include "rogue/RingQueue.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 #include "rogue/protocols/xilinx/JtagDriver.h"
@@ -48,12 +49,13 @@ class Xvc : public rogue::interfaces::stream::Master,
     unsigned mtu_;
 
     // Use rogue frames to exchange data with other rogue objects
-    rogue::Queue<std::shared_ptr<rogue::interfaces::stream::Frame>> queue_;
+    rogue::RingQueue<std::shared_ptr<rogue::interfaces::stream::Frame>> queue_;
 
     // Log
     std::shared_ptr<rogue::Logging> log_;
 
     //! Thread background
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* thread_;
     bool threadEn_;
 
@@ -82,6 +84,9 @@ class Xvc : public rogue::interfaces::stream::Master,
     //! Stop the interface
     void stop();
 
+    //! Get the thread set of the server thread
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     // Receive frame
     void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
 
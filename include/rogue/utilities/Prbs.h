@@ -23,6 +23,8 @@
 #include <memory>
 #include <thread>
 
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -60,13 +62,13 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     uint32_t rxSeq_;
 
     //! RX Error count
-    uint32_t rxErrCount_;
+    std::shared_ptr<rogue::Counter> rxErrCount_;
 
     //! Rx count
-    uint32_t rxCount_;
+    std::shared_ptr<rogue::Counter> rxCount_;
 
     //! Rx bytes
-    uint32_t rxBytes_;
+    std::shared_ptr<rogue::Counter> rxBytes_;
 
     //! tx sequence tracking
     uint32_t txSeq_;
@@ -75,13 +77,13 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     uint32_t txSize_;
 
     //! TX Error count
-    uint32_t txErrCount_;
+    std::shared_ptr<rogue::Counter> txErrCount_;
 
     //! TX count
-    uint32_t txCount_;
+    std::shared_ptr<rogue::Counter> txCount_;
 
     //! TX bytes
-    uint32_t txBytes_;
+    std::shared_ptr<rogue::Counter> txBytes_;
 
     //! Check payload
     bool checkPl_;
@@ -96,14 +98,14 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     bool rxEnable_;
 
     // Stats
-    uint32_t lastRxCount_;
-    uint32_t lastRxBytes_;
+    uint64_t lastRxCount_;
+    uint64_t lastRxBytes_;
     struct timeval lastRxTime_;
     double rxRate_;
     double rxBw_;
 
-    uint32_t lastTxCount_;
-    uint32_t lastTxBytes_;
+    uint64_t lastTxCount_;
+    uint64_t lastTxBytes_;
     struct timeval lastTxTime_;
     double txRate_;
     double txBw_;
@@ -113,6 +115,7 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     std::shared_ptr<rogue::Logging> txLog_;
 
     //! TX thread
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* txThread_;
     bool threadEn_;
 
@@ -160,6 +163,9 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     //! Disable auto generation
     void disable();
 
+    //! Get the thread set of the generation thread
+    std::shared_ptr<rogue::ThreadSet> threads();
+
     //! Get rx enable
     bool getRxEnable();
 
@@ -26,6 +26,7 @@
 #include <string>
 #include <thread>
 
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Master.h"
 
 namespace rogue {
@@ -47,6 +48,7 @@ class LegacyStreamReader : public rogue::interfaces::stream::Master {
     bool active_;
 
     //! Read thread
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* readThread_;
     bool threadEn_;
 
@@ -89,6 +91,9 @@ class LegacyStreamReader : public rogue::interfaces::stream::Master {
 
     //! Return true while reading
     bool isActive();
+
+    //! Get the thread set of the read thread
+    std::shared_ptr<rogue::ThreadSet> threads();
 };
 
 // Convenience
@@ -27,6 +27,7 @@
 #include <string>
 #include <thread>
 
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Master.h"
 
 namespace rogue {
@@ -48,6 +49,7 @@ class StreamReader : public rogue::interfaces::stream::Master {
     bool active_;
 
     //! Read thread
+    std::shared_ptr<rogue::ThreadSet> threadSet_;
     std::thread* readThread_;
     bool threadEn_;
 
@@ -93,6 +95,9 @@ class StreamReader : public rogue::interfaces::stream::Master {
 
     //! Return true while reading
     bool isActive();
+
+    //! Get the thread set of the read thread
+    std::shared_ptr<rogue::ThreadSet> threads();
 };
 
 // Convenience
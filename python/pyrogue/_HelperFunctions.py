@@ -223,6 +223,40 @@ def busConnect(source,dest):
     master._setSlave(slave)
 
 
+def setThreadConfig(*objs, cpus=None, priority=None, numaNode=None):
+    """
+    Configure the internal threads of one or more rogue objects.
+    Each object must provide the threads() call which returns its
+    rogue.ThreadSet. Settings left at None are not changed. See
+    rogue.Threads.list() for the resulting thread ids and affinity.
+
+    Parameters
+    ----------
+    *objs :
+        Rogue objects which run internal threads
+    cpus : list
+        CPU numbers to pin the threads to
+    priority : int
+        SCHED_FIFO priority 1 - 99, 0 for the default policy
+    numaNode : int
+        NUMA node to pin the threads to, used when cpus is not passed
+
+    Returns
+    -------
+
+    """
+    for obj in objs:
+        ts = obj.threads()
+
+        if cpus is not None:
+            ts.setAffinity(cpus)
+        elif numaNode is not None:
+            ts.setNumaNode(numaNode)
+
+        if priority is not None:
+            ts.setPriority(priority)
+
+
 def yamlToData(stream='',fName=None):
     """
     Load yaml to data structure.
@@ -17,10 +17,13 @@ import rogue
 import pyrogue
 
 class Fifo(pyrogue.Device):
-    def __init__(self, *, name, description='', maxDepth=0, trimSize=0, noCopy=False, **kwargs):
+    def __init__(self, *, name, description='', maxDepth=0, trimSize=0, noCopy=False, cpus=None, priority=None, numaNode=None, **kwargs):
         pyrogue.Device.__init__(self, name=name, description=description, **kwargs)
         self._fifo = rogue.interfaces.stream.Fifo(maxDepth, trimSize, noCopy)
 
+        # Thread placement
+        pyrogue.setThreadConfig(self._fifo, cpus=cpus, priority=priority, numaNode=numaNode)
+
         # Maximum Depth
         self.add(pyrogue.LocalVariable(
             name='MaxDepth',
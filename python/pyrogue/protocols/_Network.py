@@ -21,7 +21,7 @@ import time
 
 class UdpRssiPack(pr.Device):
 
-    def __init__(self,*, port, host='127.0.0.1', jumbo=False, wait=True, packVer=1, pollInterval=1, enSsi=True, server=False, **kwargs):
+    def __init__(self,*, port, host='127.0.0.1', jumbo=False, wait=True, packVer=1, pollInterval=1, enSsi=True, server=False, cpus=None, priority=None, numaNode=None, **kwargs):
         super(self.__class__, self).__init__(**kwargs)
         self._host = host
         self._port = port
@@ -41,6 +41,9 @@ class UdpRssiPack(pr.Device):
         self._udp == self._rssi.transport()
         self._rssi.application() == self._pack.transport()
 
+        # Thread placement, applied before the rssi state thread starts
+        pr.setThreadConfig(self._udp, self._rssi, self._pack, cpus=cpus, priority=priority, numaNode=numaNode)
+
         self._rssi._start()
 
         if wait and not server:
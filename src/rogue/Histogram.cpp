@@ -0,0 +1,139 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Lock free log-linear histogram
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/Histogram.h"
+
+#include <stdint.h>
+
+#include <memory>
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+rogue::HistogramPtr rogue::Histogram::create() {
+    rogue::HistogramPtr r = std::make_shared<rogue::Histogram>();
+    return (r);
+}
+
+//! Setup class in python
+void rogue::Histogram::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rogue::Histogram, rogue::HistogramPtr, boost::noncopyable>("Histogram", bp::init<>())
+        .def("getCount", &rogue::Histogram::getCount)
+        .def("getMin", &rogue::Histogram::getMin)
+        .def("getMax", &rogue::Histogram::getMax)
+        .def("getMean", &rogue::Histogram::getMean)
+        .def("getPercentile", &rogue::Histogram::getPercentile)
+        .def("record", &rogue::Histogram::record)
+        .def("reset", &rogue::Histogram::reset);
+#endif
+}
+
+//! Creator
+rogue::Histogram::Histogram() {
+    reset();
+}
+
+//! Return the lowest value stored in a bucket
+uint64_t rogue::Histogram::bucketValue(uint32_t index) {
+    uint32_t exp;
+
+    if (index < SubCount) return index;
+
+    exp = index / SubCount + SubBits - 1;
+    return (static_cast<uint64_t>(SubCount + index % SubCount) << (exp - SubBits));
+}
+
+//! Get number of recorded values
+uint64_t rogue::Histogram::getCount() {
+    return count_.load(std::memory_order_relaxed);
+}
+
+//! Get smallest recorded value
+uint64_t rogue::Histogram::getMin() {
+    if (getCount() == 0) return 0;
+    return min_.load(std::memory_order_relaxed);
+}
+
+//! Get largest recorded value
+uint64_t rogue::Histogram::getMax() {
+    return max_.load(std::memory_order_relaxed);
+}
+
+//! Get mean of recorded values
+double rogue::Histogram::getMean() {
+    uint64_t count = getCount();
+
+    if (count == 0) return 0.0;
+    return (static_cast<double>(sum_.load(std::memory_order_relaxed)) / count);
+}
+
+//! Get percentile
+/*
+ * Walk the buckets until the running count reaches the requested fraction of
+ * the total. The total is taken from the buckets themselves so that a
+ * concurrent record can not push the target past the end.
+ */
+uint64_t rogue::Histogram::getPercentile(double pct) {
+    uint64_t counts[BucketCount];
+    uint64_t total;
+    uint64_t target;
+    uint64_t run;
+    uint64_t ret;
+    uint64_t max;
+    uint32_t x;
+
+    total = 0;
+    for (x = 0; x < BucketCount; x++) {
+        counts[x] = buckets_[x].load(std::memory_order_relaxed);
+        total += counts[x];
+    }
+
+    if (total == 0) return 0;
+
+    if (pct < 0.0) pct = 0.0;
+    if (pct > 100.0) pct = 100.0;
+
+    target = static_cast<uint64_t>(pct / 100.0 * total + 0.5);
+    if (target == 0) target = 1;
+
+    run = 0;
+    for (x = 0; x < BucketCount; x++) {
+        run += counts[x];
+        if (run >= target) break;
+    }
+
+    ret = (x + 1 < BucketCount) ? bucketValue(x + 1) - 1 : UINT64_MAX;
+    max = getMax();
+    return ((ret > max) ? max : ret);
+}
+
+//! Clear all recorded values
+void rogue::Histogram::reset() {
+    uint32_t x;
+
+    for (x = 0; x < BucketCount; x++) buckets_[x].store(0, std::memory_order_relaxed);
+
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
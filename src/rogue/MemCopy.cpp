@@ -0,0 +1,140 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Runtime dispatched memory copy kernels
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/MemCopy.h"
+
+#include <stdint.h>
+
+#include <cstring>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define ROGUE_MEM_COPY_X86
+    #include <immintrin.h>
+#endif
+
+//! Plain memcpy kernel, always a cached copy
+static void memCopyStd(void* dst, const void* src, std::size_t size, bool /*stream*/) {
+    std::memcpy(dst, src, size);
+}
+
+#ifdef ROGUE_MEM_COPY_X86
+
+//! AVX2 kernel, 128 bytes per iteration
+/*
+ * Only streaming copies are vectorized here, the C library memcpy is already
+ * vectorized for cached copies. The destination is aligned to 32 bytes first,
+ * as required by the non-temporal store, and the copy is fenced at the end so
+ * the data is visible to other threads before the frame is passed on.
+ */
+__attribute__((target("avx2"))) static void memCopyAvx2(void* dst, const void* src, std::size_t size, bool stream) {
+    uint8_t* d       = reinterpret_cast<uint8_t*>(dst);
+    const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+    std::size_t head;
+
+    if (!stream) {
+        std::memcpy(dst, src, size);
+        return;
+    }
+
+    head = (32 - (reinterpret_cast<uintptr_t>(d) & 31)) & 31;
+    if (head > size) head = size;
+    std::memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+
+    for (; size >= 128; size -= 128, d += 128, s += 128) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+        __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d), a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), b);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), c);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), e);
+    }
+    _mm_sfence();
+    std::memcpy(d, s, size);
+}
+
+//! AVX-512 kernel, 256 bytes per iteration
+__attribute__((target("avx512f"))) static void memCopyAvx512(void* dst,
+                                                             const void* src,
+                                                             std::size_t size,
+                                                             bool stream) {
+    uint8_t* d       = reinterpret_cast<uint8_t*>(dst);
+    const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+    std::size_t head;
+
+    if (!stream) {
+        std::memcpy(dst, src, size);
+        return;
+    }
+
+    head = (64 - (reinterpret_cast<uintptr_t>(d) & 63)) & 63;
+    if (head > size) head = size;
+    std::memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+
+    for (; size >= 256; size -= 256, d += 256, s += 256) {
+        __m512i a = _mm512_loadu_si512(s);
+        __m512i b = _mm512_loadu_si512(s + 64);
+        __m512i c = _mm512_loadu_si512(s + 128);
+        __m512i e = _mm512_loadu_si512(s + 192);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d), a);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 64), b);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 128), c);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 192), e);
+    }
+    _mm_sfence();
+    std::memcpy(d, s, size);
+}
+
+#endif
+
+//! Return the named copy kernel
+rogue::MemCopyKernel rogue::memCopyKernel(const std::string& name) {
+    if (name == "memcpy") return memCopyStd;
+
+#ifdef ROGUE_MEM_COPY_X86
+    __builtin_cpu_init();
+    if (name == "avx2" && __builtin_cpu_supports("avx2")) return memCopyAvx2;
+    if (name == "avx512" && __builtin_cpu_supports("avx512f")) return memCopyAvx512;
+#endif
+
+    return NULL;
+}
+
+//! Return the name of the copy kernel selected for this CPU
+/*
+ * AVX2 is preferred over AVX-512 since 512 bit stores can lower the core clock
+ * on some processors, and streaming copies are memory bound either way.
+ */
+const char* rogue::memCopyName() {
+    static const char* name = (rogue::memCopyKernel("avx2") != NULL) ? "avx2" : "memcpy";
+    return name;
+}
+
+//! Return the copy kernel selected for this CPU
+rogue::MemCopyKernel rogue::memCopySelected() {
+    static rogue::MemCopyKernel kernel = rogue::memCopyKernel(rogue::memCopyName());
+    return kernel;
+}
@@ -0,0 +1,309 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Metrics registry
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/Metrics.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rogue/GilRelease.h"
+#include "rogue/Histogram.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Create a MetricSet
+rogue::MetricSetPtr rogue::MetricSet::create(const std::string& prefix) {
+    rogue::MetricSetPtr r = std::make_shared<rogue::MetricSet>(prefix);
+    return (r);
+}
+
+//! Creator
+rogue::MetricSet::MetricSet(const std::string& prefix) {
+    reg_      = rogue::Metrics::instance();
+    prefix_   = prefix;
+    attached_ = false;
+}
+
+//! Destructor
+rogue::MetricSet::~MetricSet() {
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+
+    if (attached_) {
+        reg_->sets_.erase(std::remove(reg_->sets_.begin(), reg_->sets_.end(), this), reg_->sets_.end());
+        reg_->dirty_ = true;
+    }
+}
+
+//! Add the set to the registry
+void rogue::MetricSet::attach() {
+    if (attached_) return;
+
+    if (path_.empty()) path_ = reg_->uniquePath(prefix_);
+    reg_->sets_.push_back(this);
+    attached_ = true;
+}
+
+//! Add a metric
+void rogue::MetricSet::add(const Metric& metric) {
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+    attach();
+    metrics_.push_back(metric);
+    reg_->dirty_ = true;
+}
+
+//! Register an existing counter
+void rogue::MetricSet::addCounter(const std::string& name, rogue::CounterPtr counter) {
+    Metric metric;
+
+    metric.name    = name;
+    metric.counter = counter;
+    add(metric);
+}
+
+//! Register an existing gauge
+void rogue::MetricSet::addGauge(const std::string& name, rogue::GaugePtr gauge) {
+    Metric metric;
+
+    metric.name  = name;
+    metric.gauge = gauge;
+    add(metric);
+}
+
+//! Register an existing histogram
+void rogue::MetricSet::addHistogram(const std::string& name, rogue::HistogramPtr histogram) {
+    Metric metric;
+
+    metric.name      = name;
+    metric.histogram = histogram;
+    add(metric);
+}
+
+//! Create and register a counter
+rogue::CounterPtr rogue::MetricSet::counter(const std::string& name) {
+    rogue::CounterPtr counter = rogue::Counter::create();
+    addCounter(name, counter);
+    return counter;
+}
+
+//! Create and register a gauge
+rogue::GaugePtr rogue::MetricSet::gauge(const std::string& name) {
+    rogue::GaugePtr gauge = rogue::Gauge::create();
+    addGauge(name, gauge);
+    return gauge;
+}
+
+//! Create and register a histogram
+rogue::HistogramPtr rogue::MetricSet::histogram(const std::string& name) {
+    rogue::HistogramPtr histogram = rogue::Histogram::create();
+    addHistogram(name, histogram);
+    return histogram;
+}
+
+//! Replace the path with a unique path under a new class prefix
+/*
+ * Sub-classes call this from their constructor, before any metric is added, so
+ * the index is normally taken once under the final prefix.
+ */
+void rogue::MetricSet::setPrefix(const std::string& prefix) {
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+    prefix_ = prefix;
+
+    if (attached_) {
+        path_        = reg_->uniquePath(prefix);
+        reg_->dirty_ = true;
+    }
+}
+
+//! Set the path
+void rogue::MetricSet::setPath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+    path_        = path;
+    reg_->dirty_ = true;
+}
+
+//! Get the path
+std::string rogue::MetricSet::getPath() {
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+    if (path_.empty()) path_ = reg_->uniquePath(prefix_);
+    return path_;
+}
+
+//! Get the registry
+rogue::MetricsPtr rogue::Metrics::instance() {
+    static rogue::MetricsPtr reg = std::make_shared<rogue::Metrics>();
+    return reg;
+}
+
+//! Setup class in python
+void rogue::Metrics::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rogue::Metrics, rogue::MetricsPtr, boost::noncopyable>("Metrics", bp::no_init)
+        .def("snapshot", &rogue::Metrics::snapshotPy, (bp::arg("prefix") = ""))
+        .staticmethod("snapshot")
+        .def("count", &rogue::Metrics::count)
+        .staticmethod("count");
+#endif
+}
+
+//! Creator
+rogue::Metrics::Metrics() {
+    entries_ = std::make_shared<EntryList>();
+    dirty_   = false;
+}
+
+//! Return a unique path for the passed prefix
+std::string rogue::Metrics::uniquePath(const std::string& prefix) {
+    char buffer[20];
+
+    snprintf(buffer, sizeof(buffer), "[%" PRIu32 "]", index_[prefix]++);
+    return (prefix + buffer);
+}
+
+//! Return the current snapshot
+/*
+ * Updates only mark the snapshot dirty so that creating many objects does not
+ * rebuild the list each time. Writers set the flag after updating under the
+ * lock, so a reader which sees it clear is using an up to date list.
+ */
+std::shared_ptr<const rogue::Metrics::EntryList> rogue::Metrics::entries() {
+    std::vector<rogue::MetricSet*>::iterator sit;
+    std::vector<rogue::MetricSet::Metric>::iterator mit;
+    Entry entry;
+
+    if (dirty_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        if (dirty_) {
+            std::shared_ptr<EntryList> list = std::make_shared<EntryList>();
+
+            for (sit = sets_.begin(); sit != sets_.end(); ++sit) {
+                for (mit = (*sit)->metrics_.begin(); mit != (*sit)->metrics_.end(); ++mit) {
+                    entry.path      = (*sit)->path_ + "." + mit->name;
+                    entry.counter   = mit->counter;
+                    entry.gauge     = mit->gauge;
+                    entry.histogram = mit->histogram;
+                    list->push_back(entry);
+                }
+            }
+
+            std::atomic_store(&entries_, std::shared_ptr<const EntryList>(list));
+            dirty_ = false;
+        }
+    }
+    return std::atomic_load(&entries_);
+}
+
+//! Read all metrics whose path starts with the passed prefix
+void rogue::Metrics::snapshot(std::vector<rogue::Metrics::Sample>& samples, const std::string& prefix) {
+    std::shared_ptr<const EntryList> list = rogue::Metrics::instance()->entries();
+    EntryList::const_iterator it;
+    Sample sample;
+
+    samples.clear();
+    samples.reserve(list->size());
+
+    for (it = list->begin(); it != list->end(); ++it) {
+        if (it->path.compare(0, prefix.size(), prefix) != 0) continue;
+
+        sample.count = 0;
+        sample.level = 0;
+        sample.value = 0.0;
+
+        if (it->counter) {
+            sample.path  = it->path;
+            sample.type  = CounterType;
+            sample.count = it->counter->get();
+            samples.push_back(sample);
+
+        } else if (it->gauge) {
+            sample.path  = it->path;
+            sample.type  = GaugeType;
+            sample.level = it->gauge->get();
+            samples.push_back(sample);
+
+        } else if (it->histogram) {
+            sample.type = CounterType;
+
+            sample.path  = it->path + ".count";
+            sample.count = it->histogram->getCount();
+            samples.push_back(sample);
+
+            sample.path  = it->path + ".min";
+            sample.count = it->histogram->getMin();
+            samples.push_back(sample);
+
+            sample.path  = it->path + ".max";
+            sample.count = it->histogram->getMax();
+            samples.push_back(sample);
+
+            sample.path  = it->path + ".p50";
+            sample.count = it->histogram->getPercentile(50.0);
+            samples.push_back(sample);
+
+            sample.path  = it->path + ".p99";
+            sample.count = it->histogram->getPercentile(99.0);
+            samples.push_back(sample);
+
+            sample.path  = it->path + ".mean";
+            sample.type  = ValueType;
+            sample.count = 0;
+            sample.value = it->histogram->getMean();
+            samples.push_back(sample);
+        }
+    }
+}
+
+//! Get number of registered metrics
+uint32_t rogue::Metrics::count() {
+    return rogue::Metrics::instance()->entries()->size();
+}
+
+#ifndef NO_PYTHON
+
+//! Read all metrics into a dictionary keyed by path
+bp::dict rogue::Metrics::snapshotPy(const std::string& prefix) {
+    std::vector<Sample> samples;
+    std::vector<Sample>::iterator it;
+    bp::dict ret;
+
+    {
+        rogue::GilRelease noGil;
+        snapshot(samples, prefix);
+    }
+
+    for (it = samples.begin(); it != samples.end(); ++it) {
+        if (it->type == CounterType)
+            ret[it->path] = it->count;
+        else if (it->type == GaugeType)
+            ret[it->path] = it->level;
+        else
+            ret[it->path] = it->value;
+    }
+    return ret;
+}
+
+#endif
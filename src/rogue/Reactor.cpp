@@ -0,0 +1,298 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Shared epoll reactor for socket and device receive
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/Reactor.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Histogram.h"
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+#endif
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+// Event key of the stop descriptor, handler keys always have a non-zero generation
+static const uint64_t StopKey = 0;
+
+// Handler being run by the current thread, allows a handler to remove itself
+static thread_local void* currentHandler = NULL;
+
+//! Class creation
+rogue::ReactorPtr rogue::Reactor::create(uint32_t threads) {
+    rogue::ReactorPtr r = std::make_shared<rogue::Reactor>(threads);
+    return (r);
+}
+
+//! Setup class in python
+void rogue::Reactor::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rogue::Reactor, rogue::ReactorPtr, boost::noncopyable>("Reactor", bp::init<uint32_t>())
+        .def("setBusyPoll", &rogue::Reactor::setBusyPoll)
+        .def("getBusyPoll", &rogue::Reactor::getBusyPoll)
+        .def("count", &rogue::Reactor::count)
+        .def("threads", &rogue::Reactor::threads);
+#endif
+}
+
+//! Creator
+rogue::Reactor::Reactor(uint32_t threads) {
+#if defined(__linux__)
+    struct epoll_event ev;
+    uint32_t x;
+
+    if (threads == 0) throw(rogue::GeneralError::create("Reactor::Reactor", "Thread count must be at least 1"));
+
+    log_       = rogue::Logging::create("Reactor");
+    threadSet_ = rogue::ThreadSet::create("Reactor");
+    metrics_   = rogue::MetricSet::create("Reactor");
+    wakeCnt_   = metrics_->counter("wakeCount");
+    pollCnt_   = metrics_->counter("busyPollCount");
+    gen_       = 0;
+    busyPoll_  = 0;
+    threadEn_  = true;
+
+    if ((epFd_ = epoll_create1(EPOLL_CLOEXEC)) < 0)
+        throw(rogue::GeneralError::create("Reactor::Reactor",
+                                          "Failed to create epoll descriptor: %s",
+                                          strerror(errno)));
+
+    if ((stopFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0) {
+        ::close(epFd_);
+        throw(rogue::GeneralError::create("Reactor::Reactor",
+                                          "Failed to create event descriptor: %s",
+                                          strerror(errno)));
+    }
+
+    // Level triggered and never read, wakes every thread once set
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN;
+    ev.data.u64 = StopKey;
+    epoll_ctl(epFd_, EPOLL_CTL_ADD, stopFd_, &ev);
+
+    for (x = 0; x < threads; x++)
+        threads_.push_back(threadSet_->start("Reactor", std::bind(&rogue::Reactor::runThread, this)));
+#else
+    throw(rogue::GeneralError::create("Reactor::Reactor", "Reactor is only supported on Linux"));
+#endif
+}
+
+//! Destructor
+rogue::Reactor::~Reactor() {
+#if defined(__linux__)
+    std::vector<std::thread*>::iterator it;
+    uint64_t val = 1;
+    rogue::GilRelease noGil;
+
+    threadEn_ = false;
+    if (::write(stopFd_, &val, sizeof(val)) < 0) log_->warning("Failed to signal stop: %s", strerror(errno));
+
+    for (it = threads_.begin(); it != threads_.end(); ++it) {
+        (*it)->join();
+        delete *it;
+    }
+
+    ::close(stopFd_);
+    ::close(epFd_);
+#endif
+}
+
+//! Register a descriptor
+void rogue::Reactor::add(int32_t fd, std::function<void()> func) {
+#if defined(__linux__)
+    std::shared_ptr<Handler> h;
+    struct epoll_event ev;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (handlers_.find(fd) != handlers_.end())
+        throw(rogue::GeneralError::create("Reactor::add", "Descriptor %" PRIi32 " is already registered", fd));
+
+    if (++gen_ == 0) ++gen_;
+
+    h          = std::make_shared<Handler>();
+    h->fd      = fd;
+    h->gen     = gen_;
+    h->func    = func;
+    h->busy    = false;
+    h->removed = false;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN | EPOLLET | EPOLLONESHOT;
+    ev.data.u64 = (static_cast<uint64_t>(h->gen) << 32) | static_cast<uint32_t>(fd);
+
+    if (epoll_ctl(epFd_, EPOLL_CTL_ADD, fd, &ev) < 0)
+        throw(rogue::GeneralError::create("Reactor::add",
+                                          "Failed to register descriptor %" PRIi32 ": %s",
+                                          fd,
+                                          strerror(errno)));
+
+    handlers_[fd] = h;
+#endif
+}
+
+//! Remove a descriptor
+void rogue::Reactor::remove(int32_t fd) {
+#if defined(__linux__)
+    std::map<int32_t, std::shared_ptr<Handler> >::iterator it;
+    std::shared_ptr<Handler> h;
+
+    rogue::GilRelease noGil;
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    if ((it = handlers_.find(fd)) == handlers_.end()) return;
+
+    h          = it->second;
+    h->removed = true;
+    handlers_.erase(it);
+    epoll_ctl(epFd_, EPOLL_CTL_DEL, fd, NULL);
+
+    // Wait for a running handler to return unless this is that handler
+    if (currentHandler != h.get())
+        while (h->busy) cond_.wait(lock);
+#endif
+}
+
+//! Set the busy poll time
+void rogue::Reactor::setBusyPoll(uint32_t usec) {
+    busyPoll_ = usec;
+}
+
+//! Get the busy poll time
+uint32_t rogue::Reactor::getBusyPoll() {
+    return busyPoll_;
+}
+
+//! Get the number of registered descriptors
+uint32_t rogue::Reactor::count() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return handlers_.size();
+}
+
+//! Get the thread set of the pool threads
+rogue::ThreadSetPtr rogue::Reactor::threads() {
+    return threadSet_;
+}
+
+//! Run thread
+void rogue::Reactor::runThread() {
+#if defined(__linux__)
+    struct epoll_event events[MaxEvents];
+    uint64_t last;
+    uint64_t busy;
+    bool spin;
+    int32_t cnt;
+    int32_t x;
+
+    log_->logThreadId();
+
+    last = 0;
+
+    while (threadEn_) {
+        // Poll without sleeping for the busy poll time after the last event
+        busy = static_cast<uint64_t>(busyPoll_) * 1000ULL;
+        spin = (busy != 0) && ((rogue::monotonicNs() - last) < busy);
+
+        if ((cnt = epoll_wait(epFd_, events, MaxEvents, spin ? 0 : -1)) < 0) {
+            if (errno != EINTR) log_->warning("Wait failed: %s", strerror(errno));
+            continue;
+        }
+        if (cnt == 0) continue;
+
+        if (spin)
+            pollCnt_->inc();
+        else
+            wakeCnt_->inc();
+
+        for (x = 0; x < cnt; x++)
+            if (events[x].data.u64 != StopKey) handle(events[x].data.u64);
+
+        last = rogue::monotonicNs();
+    }
+#endif
+}
+
+//! Handle one event
+void rogue::Reactor::handle(uint64_t key) {
+#if defined(__linux__)
+    std::map<int32_t, std::shared_ptr<Handler> >::iterator it;
+    std::shared_ptr<Handler> h;
+    struct epoll_event ev;
+    int32_t fd;
+
+    fd = static_cast<int32_t>(key & 0xFFFFFFFF);
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        // Event for a descriptor which was removed, possibly with the number reused
+        if ((it = handlers_.find(fd)) == handlers_.end() || it->second->gen != (key >> 32)) return;
+
+        h       = it->second;
+        h->busy = true;
+    }
+
+    currentHandler = h.get();
+
+    try {
+        h->func();
+    } catch (std::exception& e) {
+        log_->warning("Handler for descriptor %" PRIi32 " failed: %s", fd, e.what());
+    }
+
+    currentHandler = NULL;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    h->busy = false;
+
+    // Re-arm, the kernel reports the descriptor again if data arrived after the handler
+    // stopped reading
+    if (!h->removed) {
+        memset(&ev, 0, sizeof(ev));
+        ev.events   = EPOLLIN | EPOLLET | EPOLLONESHOT;
+        ev.data.u64 = key;
+        epoll_ctl(epFd_, EPOLL_CTL_MOD, fd, &ev);
+    } else {
+        cond_.notify_all();
+    }
+#endif
+}
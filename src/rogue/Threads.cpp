@@ -0,0 +1,434 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Thread registry with affinity and scheduling control
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/Threads.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+
+#if defined(__linux__)
+    #include <sys/syscall.h>
+#endif
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Return the CPUs of a NUMA node
+static std::vector<uint32_t> nodeCpus(int32_t node) {
+    std::vector<uint32_t> cpus;
+    char path[100];
+    char line[1000];
+    char* tok;
+    char* save;
+    uint32_t first;
+    uint32_t last;
+    uint32_t x;
+    FILE* f;
+
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%" PRIi32 "/cpulist", node);
+
+    if ((f = fopen(path, "r")) == NULL)
+        throw(rogue::GeneralError::create("ThreadSet::setNumaNode", "Invalid NUMA node %" PRIi32, node));
+
+    if (fgets(line, sizeof(line), f) == NULL) line[0] = 0;
+    fclose(f);
+
+    // Format is a list of ranges, for example 0-7,16-23
+    for (tok = strtok_r(line, ",\n", &save); tok != NULL; tok = strtok_r(NULL, ",\n", &save)) {
+        if (sscanf(tok, "%" SCNu32 "-%" SCNu32, &first, &last) == 1) last = first;
+        for (x = first; x <= last; x++) cpus.push_back(x);
+    }
+    return cpus;
+}
+
+//! Create a ThreadSet
+rogue::ThreadSetPtr rogue::ThreadSet::create(const std::string& prefix) {
+    rogue::ThreadSetPtr r = std::make_shared<rogue::ThreadSet>(prefix);
+    return (r);
+}
+
+//! Setup class in python
+void rogue::ThreadSet::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rogue::ThreadSet, rogue::ThreadSetPtr, boost::noncopyable>("ThreadSet", bp::no_init)
+        .def("setAffinity", &rogue::ThreadSet::setAffinityPy)
+        .def("getAffinity", &rogue::ThreadSet::getAffinityPy)
+        .def("setNumaNode", &rogue::ThreadSet::setNumaNode)
+        .def("getNumaNode", &rogue::ThreadSet::getNumaNode)
+        .def("setPriority", &rogue::ThreadSet::setPriority)
+        .def("getPriority", &rogue::ThreadSet::getPriority)
+        .def("getIds", &rogue::ThreadSet::getIdsPy)
+        .def("setPath", &rogue::ThreadSet::setPath)
+        .def("getPath", &rogue::ThreadSet::getPath);
+#endif
+}
+
+//! Creator
+rogue::ThreadSet::ThreadSet(const std::string& prefix) {
+    reg_      = rogue::Threads::instance();
+    log_      = rogue::Logging::create("ThreadSet");
+    priority_ = 0;
+    numaNode_ = -1;
+
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+    path_ = reg_->uniquePath(prefix);
+    reg_->sets_.push_back(this);
+}
+
+//! Destructor
+rogue::ThreadSet::~ThreadSet() {
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+    reg_->sets_.erase(std::remove(reg_->sets_.begin(), reg_->sets_.end(), this), reg_->sets_.end());
+}
+
+//! Start a thread
+std::thread* rogue::ThreadSet::start(const std::string& name, std::function<void()> func) {
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+    std::thread* thread;
+
+    entry->name = name;
+    entry->tid  = 0;
+
+    // The thread waits in run() until the handle has been recorded
+    std::lock_guard<std::mutex> lock(mtx_);
+    thread        = new std::thread(&rogue::ThreadSet::run, this, entry, func);
+    entry->handle = thread->native_handle();
+    entries_.push_back(entry);
+
+    // Set a thread name
+#ifndef __MACH__
+    pthread_setname_np(entry->handle, name.c_str());
+#endif
+    return thread;
+}
+
+//! Thread entry point
+void rogue::ThreadSet::run(std::shared_ptr<Entry> entry, std::function<void()> func) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+#if defined(__linux__)
+        entry->tid = syscall(SYS_gettid);
+#endif
+
+        // Threads keep the inherited settings unless configured
+        try {
+            if (!cpus_.empty()) applyAffinity(pthread_self());
+            if (priority_ != 0) applyPriority(pthread_self());
+        } catch (rogue::GeneralError& e) {
+            log_->warning("Thread %s: %s", entry->name.c_str(), e.what());
+        }
+    }
+
+    func();
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    entries_.erase(std::remove(entries_.begin(), entries_.end(), entry), entries_.end());
+}
+
+//! Apply the affinity setting to a thread
+void rogue::ThreadSet::applyAffinity(pthread_t handle) {
+#if defined(__linux__)
+    std::vector<uint32_t>::iterator it;
+    cpu_set_t set;
+    int res;
+
+    if (cpus_.empty()) {
+        // Restore the affinity of the process
+        if (sched_getaffinity(getpid(), sizeof(set), &set) != 0) return;
+    } else {
+        CPU_ZERO(&set);
+        for (it = cpus_.begin(); it != cpus_.end(); ++it) CPU_SET(*it, &set);
+    }
+
+    if ((res = pthread_setaffinity_np(handle, sizeof(set), &set)) != 0)
+        throw(rogue::GeneralError::create("ThreadSet::setAffinity", "Failed to set affinity: %s", strerror(res)));
+#else
+    if (!cpus_.empty())
+        throw(rogue::GeneralError::create("ThreadSet::setAffinity", "CPU affinity is not supported on this platform"));
+#endif
+}
+
+//! Apply the priority setting to a thread
+void rogue::ThreadSet::applyPriority(pthread_t handle) {
+    struct sched_param param;
+    int res;
+
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority_;
+
+    if ((res = pthread_setschedparam(handle, (priority_ == 0) ? SCHED_OTHER : SCHED_FIFO, &param)) != 0)
+        throw(rogue::GeneralError::create("ThreadSet::setPriority",
+                                          "Failed to set SCHED_FIFO priority %" PRIu32 ": %s",
+                                          priority_,
+                                          strerror(res)));
+}
+
+//! Set the CPU affinity of all threads
+void rogue::ThreadSet::setAffinity(const std::vector<uint32_t>& cpus) {
+    std::vector<std::shared_ptr<Entry> >::iterator it;
+    std::vector<uint32_t>::const_iterator cit;
+
+#if defined(__linux__)
+    for (cit = cpus.begin(); cit != cpus.end(); ++cit) {
+        if (*cit >= CPU_SETSIZE)
+            throw(rogue::GeneralError::create("ThreadSet::setAffinity", "Invalid CPU %" PRIu32, *cit));
+    }
+#endif
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    cpus_     = cpus;
+    numaNode_ = -1;
+    for (it = entries_.begin(); it != entries_.end(); ++it) applyAffinity((*it)->handle);
+}
+
+//! Get the configured CPU affinity
+std::vector<uint32_t> rogue::ThreadSet::getAffinity() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return cpus_;
+}
+
+//! Set the affinity of all threads to the CPUs of a NUMA node
+void rogue::ThreadSet::setNumaNode(int32_t node) {
+    std::vector<uint32_t> cpus;
+
+    if (node >= 0) cpus = nodeCpus(node);
+
+    setAffinity(cpus);
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    numaNode_ = node;
+}
+
+//! Get the configured NUMA node
+int32_t rogue::ThreadSet::getNumaNode() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return numaNode_;
+}
+
+//! Set the real time priority of all threads
+void rogue::ThreadSet::setPriority(uint32_t priority) {
+    std::vector<std::shared_ptr<Entry> >::iterator it;
+    uint32_t prev;
+
+    if (priority > static_cast<uint32_t>(sched_get_priority_max(SCHED_FIFO)))
+        throw(rogue::GeneralError::create("ThreadSet::setPriority", "Invalid priority %" PRIu32, priority));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    prev      = priority_;
+    priority_ = priority;
+
+    // Keep the previous setting for new threads if the change is not permitted
+    try {
+        for (it = entries_.begin(); it != entries_.end(); ++it) applyPriority((*it)->handle);
+    } catch (rogue::GeneralError& e) {
+        priority_ = prev;
+        throw;
+    }
+}
+
+//! Get the configured real time priority
+uint32_t rogue::ThreadSet::getPriority() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return priority_;
+}
+
+//! Get the kernel thread IDs of the running threads
+std::vector<uint32_t> rogue::ThreadSet::getIds() {
+    std::vector<std::shared_ptr<Entry> >::iterator it;
+    std::vector<uint32_t> ret;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    for (it = entries_.begin(); it != entries_.end(); ++it) ret.push_back((*it)->tid);
+    return ret;
+}
+
+//! Set the path
+void rogue::ThreadSet::setPath(const std::string& path) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+    path_ = path;
+}
+
+//! Get the path
+std::string rogue::ThreadSet::getPath() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(reg_->mtx_);
+    return path_;
+}
+
+#ifndef NO_PYTHON
+
+//! Set the CPU affinity from a python list
+void rogue::ThreadSet::setAffinityPy(bp::object cpus) {
+    std::vector<uint32_t> list;
+    uint32_t x;
+
+    for (x = 0; x < bp::len(cpus); x++) list.push_back(bp::extract<uint32_t>(cpus[x]));
+    setAffinity(list);
+}
+
+//! Get the configured CPU affinity as a python list
+bp::list rogue::ThreadSet::getAffinityPy() {
+    std::vector<uint32_t> cpus = getAffinity();
+    std::vector<uint32_t>::iterator it;
+    bp::list ret;
+
+    for (it = cpus.begin(); it != cpus.end(); ++it) ret.append(*it);
+    return ret;
+}
+
+//! Get the kernel thread IDs as a python list
+bp::list rogue::ThreadSet::getIdsPy() {
+    std::vector<uint32_t> ids = getIds();
+    std::vector<uint32_t>::iterator it;
+    bp::list ret;
+
+    for (it = ids.begin(); it != ids.end(); ++it) ret.append(*it);
+    return ret;
+}
+
+#endif
+
+//! Get the registry
+rogue::ThreadsPtr rogue::Threads::instance() {
+    static rogue::ThreadsPtr reg = std::make_shared<rogue::Threads>();
+    return reg;
+}
+
+//! Setup class in python
+void rogue::Threads::setup_python() {
+#ifndef NO_PYTHON
+    rogue::ThreadSet::setup_python();
+
+    bp::class_<rogue::Threads, rogue::ThreadsPtr, boost::noncopyable>("Threads", bp::no_init)
+        .def("list", &rogue::Threads::listPy)
+        .staticmethod("list");
+#endif
+}
+
+//! Creator
+rogue::Threads::Threads() {}
+
+//! Return a unique path for the passed prefix
+std::string rogue::Threads::uniquePath(const std::string& prefix) {
+    char buffer[20];
+
+    snprintf(buffer, sizeof(buffer), "[%" PRIu32 "]", index_[prefix]++);
+    return (prefix + buffer);
+}
+
+//! Get information on all running threads
+void rogue::Threads::list(std::vector<rogue::Threads::Info>& info) {
+    rogue::ThreadsPtr reg = rogue::Threads::instance();
+    std::vector<rogue::ThreadSet*>::iterator sit;
+    std::vector<std::shared_ptr<rogue::ThreadSet::Entry> >::iterator eit;
+    struct sched_param param;
+    int policy;
+    Info entry;
+    uint32_t x;
+
+    info.clear();
+
+    std::lock_guard<std::mutex> lock(reg->mtx_);
+
+    for (sit = reg->sets_.begin(); sit != reg->sets_.end(); ++sit) {
+        std::lock_guard<std::mutex> slock((*sit)->mtx_);
+
+        for (eit = (*sit)->entries_.begin(); eit != (*sit)->entries_.end(); ++eit) {
+            entry.path     = (*sit)->path_;
+            entry.name     = (*eit)->name;
+            entry.tid      = (*eit)->tid;
+            entry.priority = 0;
+            entry.cpus.clear();
+
+#if defined(__linux__)
+            cpu_set_t set;
+
+            if (pthread_getaffinity_np((*eit)->handle, sizeof(set), &set) == 0) {
+                for (x = 0; x < CPU_SETSIZE; x++)
+                    if (CPU_ISSET(x, &set)) entry.cpus.push_back(x);
+            }
+#endif
+
+            if (pthread_getschedparam((*eit)->handle, &policy, &param) == 0 && policy != SCHED_OTHER)
+                entry.priority = param.sched_priority;
+
+            info.push_back(entry);
+        }
+    }
+}
+
+#ifndef NO_PYTHON
+
+//! Get information on all running threads as a python list
+bp::list rogue::Threads::listPy() {
+    std::vector<Info> info;
+    std::vector<Info>::iterator it;
+    std::vector<uint32_t>::iterator cit;
+    bp::list ret;
+
+    {
+        rogue::GilRelease noGil;
+        list(info);
+    }
+
+    for (it = info.begin(); it != info.end(); ++it) {
+        bp::dict d;
+        bp::list cpus;
+
+        for (cit = it->cpus.begin(); cit != it->cpus.end(); ++cit) cpus.append(*cit);
+
+        d["path"]     = it->path;
+        d["name"]     = it->name;
+        d["tid"]      = it->tid;
+        d["cpus"]     = cpus;
+        d["priority"] = it->priority;
+        ret.append(d);
+    }
+    return ret;
+}
+
+#endif
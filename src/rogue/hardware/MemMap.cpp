@@ -27,11 +27,13 @@
 
 #include <cstdio>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <thread>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/memory/Constants.h"
 #include "rogue/interfaces/memory/Transaction.h"
 #include "rogue/interfaces/memory/TransactionLock.h"
@@ -52,7 +54,8 @@ rh::MemMapPtr rh::MemMap::create(uint64_t base, uint32_t size) {
 
 //! Creator
 rh::MemMap::MemMap(uint64_t base, uint32_t size) : rim::Slave(4, 0xFFFFFFFF) {
-    log_ = rogue::Logging::create("MemMap");
+    log_       = rogue::Logging::create("MemMap");
+    threadSet_ = rogue::ThreadSet::create("MemMap");
 
     size_ = size;
 
@@ -68,7 +71,7 @@ rh::MemMap::MemMap(uint64_t base, uint32_t size) : rim::Slave(4, 0xFFFFFFFF) {
 
     // Start read thread
     threadEn_ = true;
-    thread_   = new std::thread(&rh::MemMap::runThread, this);
+    thread_   = threadSet_->start("MemMap", std::bind(&rh::MemMap::runThread, this));
 }
 
 //! Destructor
@@ -87,6 +90,11 @@ void rh::MemMap::stop() {
     }
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rh::MemMap::threads() {
+    return threadSet_;
+}
+
 //! Post a transaction
 void rh::MemMap::doTransaction(rim::TransactionPtr tran) {
     rogue::GilRelease noGil;
@@ -160,7 +168,8 @@ void rh::MemMap::setup_python() {
 #ifndef NO_PYTHON
 
     bp::class_<rh::MemMap, rh::MemMapPtr, bp::bases<rim::Slave>, boost::noncopyable>("MemMap",
-                                                                                     bp::init<uint64_t, uint32_t>());
+                                                                                     bp::init<uint64_t, uint32_t>())
+        .def("threads", &rh::MemMap::threads);
 
     bp::implicitly_convertible<rh::MemMapPtr, rim::SlavePtr>();
 #endif
@@ -27,12 +27,14 @@
 
 #include <cstdio>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Threads.h"
 #include "rogue/hardware/drivers/AxisDriver.h"
 #include "rogue/interfaces/memory/Constants.h"
 #include "rogue/interfaces/memory/Transaction.h"
@@ -54,8 +56,9 @@ rha::AxiMemMapPtr rha::AxiMemMap::create(std::string path) {
 
 //! Creator
 rha::AxiMemMap::AxiMemMap(std::string path) : rim::Slave(4, 0xFFFFFFFF) {
-    fd_  = ::open(path.c_str(), O_RDWR);
-    log_ = rogue::Logging::create("axi.AxiMemMap");
+    fd_        = ::open(path.c_str(), O_RDWR);
+    log_       = rogue::Logging::create("axi.AxiMemMap");
+    threadSet_ = rogue::ThreadSet::create("axi.AxiMemMap");
     if (fd_ < 0)
         throw(rogue::GeneralError::create("AxiMemMap::AxiMemMap", "Failed to open device file: %s", path.c_str()));
 
@@ -79,7 +82,7 @@ rha::AxiMemMap::AxiMemMap(std::string path) : rim::Slave(4, 0xFFFFFFFF) {
 
     // Start read thread
     threadEn_ = true;
-    thread_   = new std::thread(&rha::AxiMemMap::runThread, this);
+    thread_   = threadSet_->start("AxiMemMap", std::bind(&rha::AxiMemMap::runThread, this));
 }
 
 //! Destructor
@@ -98,6 +101,11 @@ void rha::AxiMemMap::stop() {
     }
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rha::AxiMemMap::threads() {
+    return threadSet_;
+}
+
 //! Post a transaction
 void rha::AxiMemMap::doTransaction(rim::TransactionPtr tran) {
     rogue::GilRelease noGil;
@@ -175,7 +183,8 @@ void rha::AxiMemMap::setup_python() {
 #ifndef NO_PYTHON
 
     bp::class_<rha::AxiMemMap, rha::AxiMemMapPtr, bp::bases<rim::Slave>, boost::noncopyable>("AxiMemMap",
-                                                                                             bp::init<std::string>());
+                                                                                             bp::init<std::string>())
+        .def("threads", &rha::AxiMemMap::threads);
 
     bp::implicitly_convertible<rha::AxiMemMapPtr, rim::SlavePtr>();
 #endif
@@ -20,15 +20,24 @@
 
 #include <inttypes.h>
 
+#include <sys/timerfd.h>
+
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Helpers.h"
+#include "rogue/Histogram.h"
+#include "rogue/Reactor.h"
+#include "rogue/Threads.h"
 #include "rogue/hardware/drivers/AxisDriver.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
@@ -170,24 +179,44 @@ void rha::AxiStreamDma::zeroCopyDisable(std::string path) {
 rha::AxiStreamDma::AxiStreamDma(std::string path, uint32_t dest, bool ssiEnable) {
     uint8_t mask[DMA_MASK_SIZE];
 
-    dest_     = dest;
-    enSsi_    = ssiEnable;
-    retThold_ = 1;
+    dest_       = dest;
+    enSsi_      = ssiEnable;
+    retCount_   = 0;
+    retFirst_   = 0;
+    retThold_   = 1;
+    retTime_    = 1000;
+    retTimerFd_ = -1;
+    txThread_   = NULL;
+    txEn_       = false;
+    txDrop_     = false;
+    txRun_      = true;
+    busyPoll_   = 0;
 
     // Create a shared pointer to use as a lock for runThread()
     std::shared_ptr<int> scopePtr = std::make_shared<int>(0);
 
     rogue::defaultTimeout(timeout_);
 
-    log_ = rogue::Logging::create("axi.AxiStreamDma");
+    log_       = rogue::Logging::create("axi.AxiStreamDma");
+    threadSet_ = rogue::ThreadSet::create("axi.AxiStreamDma");
+
+    metrics_->setPrefix("axi.AxiStreamDma");
+    retBatchCnt_ = metrics_->counter("retBatchCount");
+    retBuffCnt_  = metrics_->counter("retBuffCount");
+    retTimeCnt_  = metrics_->counter("retTimeoutCount");
+
+    txDropCnt_    = metrics_->counter("txDropCount");
+    txTimeoutCnt_ = metrics_->counter("txTimeoutCount");
+
+    pollCnt_   = metrics_->counter("busyPollCount");
+    pollTime_  = metrics_->counter("busyPollTime");
+    blockTime_ = metrics_->counter("blockTime");
 
     rogue::GilRelease noGil;
 
     // Attempt to open shared structure
     desc_ = openShared(path, log_);
 
-    if (desc_->bCount >= 1000) retThold_ = 80;
-
     // Open non shared file descriptor
     if ((fd_ = ::open(path.c_str(), O_RDWR)) < 0) {
         closeShared(desc_);
@@ -200,6 +229,8 @@ rha::AxiStreamDma::AxiStreamDma(std::string path, uint32_t dest, bool ssiEnable)
         desc_->bCount = dmaGetTxBuffCount(fd_) + dmaGetRxBuffCount(fd_);
         desc_->bSize  = dmaGetBuffSize(fd_);
     }
+
+    // Batch buffer returns by default for large buffer counts
     if (desc_->bCount >= 1000) retThold_ = 80;
 
     dmaInitMaskBytes(mask);
@@ -215,14 +246,13 @@ rha::AxiStreamDma::AxiStreamDma(std::string path, uint32_t dest, bool ssiEnable)
                                           dest));
     }
 
+    // Preallocate empty frame
+    rxFrame_ = ris::Frame::create();
+
     // Start read thread
     threadEn_ = true;
-    thread_   = new std::thread(&rha::AxiStreamDma::runThread, this, std::weak_ptr<int>(scopePtr));
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "AxiStreamDma");
-#endif
+    thread_   = threadSet_->start("AxiStreamDma",
+                                std::bind(&rha::AxiStreamDma::runThread, this, std::weak_ptr<int>(scopePtr)));
 }
 
 //! Close the device
@@ -231,12 +261,33 @@ rha::AxiStreamDma::~AxiStreamDma() {
 }
 
 void rha::AxiStreamDma::stop() {
-    if (threadEn_) {
+    if (threadEn_ || reactor_) {
         rogue::GilRelease noGil;
 
-        // Stop read thread
-        threadEn_ = false;
-        thread_->join();
+        // Stop the transmit thread, queued frames are dropped
+        txRun_ = false;
+        if (txEn_) {
+            txQueue_.stop();
+            txThread_->join();
+            delete txThread_;
+            txThread_ = NULL;
+            txEn_     = false;
+        }
+
+        // Stop read thread or leave the reactor
+        if (reactor_) {
+            reactor_->remove(fd_);
+            reactor_->remove(retTimerFd_);
+            reactor_.reset();
+            ::close(retTimerFd_);
+            retTimerFd_ = -1;
+        } else {
+            threadEn_ = false;
+            thread_->join();
+        }
+
+        // Return held buffers before the device is closed
+        retFlush(true);
 
         closeShared(desc_);
         ::close(fd_);
@@ -244,6 +295,136 @@ void rha::AxiStreamDma::stop() {
     }
 }
 
+//! Receive using a shared reactor
+void rha::AxiStreamDma::setReactor(rogue::ReactorPtr reactor) {
+    rogue::GilRelease noGil;
+
+    if (reactor_ || !threadEn_)
+        throw(rogue::GeneralError::create("AxiStreamDma::setReactor",
+                                          "Interface is stopped or already uses a reactor"));
+
+    // Held buffers are flushed from a timer instead of the read thread, create it before the thread is retired
+    int32_t timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd < 0) throw(rogue::GeneralError::create("AxiStreamDma::setReactor", "Failed to create return timer"));
+
+    // Retire the read thread, the reactor reads from here on
+    threadEn_ = false;
+    thread_->join();
+    delete thread_;
+    thread_ = NULL;
+
+    retTimerFd_ = timerFd;
+    retTimerSet();
+
+    try {
+        reactor_ = reactor;
+        reactor_->add(fd_, std::bind(&rha::AxiStreamDma::rxReady, this));
+        reactor_->add(retTimerFd_, std::bind(&rha::AxiStreamDma::retTimer, this));
+    } catch (...) {
+        // Go back to the read thread
+        reactor_->remove(fd_);
+        reactor_.reset();
+        ::close(retTimerFd_);
+        retTimerFd_ = -1;
+
+        threadEn_ = true;
+        thread_   = threadSet_->start("AxiStreamDma",
+                                    std::bind(&rha::AxiStreamDma::runThread, this, std::weak_ptr<int>()));
+        throw;
+    }
+}
+
+//! Configure batched return of zero copy buffers
+void rha::AxiStreamDma::setRetBatch(uint32_t count, uint32_t time) {
+    if (count == 0 || count > RetBufferCount || time == 0)
+        throw(rogue::GeneralError::create("AxiStreamDma::setRetBatch",
+                                          "Invalid return batch count %" PRIu32 " or time %" PRIu32,
+                                          count,
+                                          time));
+
+    rogue::GilRelease noGil;
+    {
+        std::lock_guard<std::mutex> lock(retMtx_);
+        retThold_ = count;
+        retTime_  = time;
+    }
+    if (retTimerFd_ >= 0) retTimerSet();
+
+    // Apply the new limits to buffers which are already held
+    retFlush(count == 1);
+}
+
+//! Set the busy poll time
+void rha::AxiStreamDma::setBusyPoll(uint32_t usec) {
+    busyPoll_ = usec;
+}
+
+//! Get the busy poll time in microseconds
+uint32_t rha::AxiStreamDma::getBusyPoll() {
+    return busyPoll_;
+}
+
+//! Get the number of reads which returned buffers while polling
+uint64_t rha::AxiStreamDma::getBusyPollCount() {
+    return pollCnt_->get();
+}
+
+//! Get the time spent polling without receiving buffers
+uint64_t rha::AxiStreamDma::getBusyPollTime() {
+    return pollTime_->get();
+}
+
+//! Get the time spent waiting in select
+uint64_t rha::AxiStreamDma::getBlockTime() {
+    return blockTime_->get();
+}
+
+//! Enable the transmit queue
+void rha::AxiStreamDma::setTxQueue(uint32_t depth, bool drop) {
+    if (depth == 0)
+        throw(rogue::GeneralError::create("AxiStreamDma::setTxQueue", "Transmit queue depth must not be zero"));
+
+    rogue::GilRelease noGil;
+
+    txQueue_.setMax(depth);
+    txDrop_ = drop;
+
+    if (!txEn_ && txRun_) {
+        txThread_ = threadSet_->start("AxiStreamDmaTx", std::bind(&rha::AxiStreamDma::runTxThread, this));
+        txEn_     = true;
+    }
+}
+
+//! Get the number of frames in the transmit queue
+uint32_t rha::AxiStreamDma::getTxQueueDepth() {
+    return txQueue_.size();
+}
+
+//! Get the number of frames dropped because the transmit queue was full
+uint64_t rha::AxiStreamDma::getTxDropCount() {
+    return txDropCnt_->get();
+}
+
+//! Get the number of transmit timeouts
+uint64_t rha::AxiStreamDma::getTxTimeoutCount() {
+    return txTimeoutCnt_->get();
+}
+
+//! Get the number of buffer return calls to the driver
+uint64_t rha::AxiStreamDma::getRetBatchCount() {
+    return retBatchCnt_->get();
+}
+
+//! Get the number of buffers returned to the driver
+uint64_t rha::AxiStreamDma::getRetBuffCount() {
+    return retBuffCnt_->get();
+}
+
+//! Get the number of return batches sent because the hold time expired
+uint64_t rha::AxiStreamDma::getRetTimeoutCount() {
+    return retTimeCnt_->get();
+}
+
 //! Set timeout for frame transmits in microseconds
 void rha::AxiStreamDma::setTimeout(uint32_t timeout) {
     if (timeout > 0) {
@@ -263,6 +444,11 @@ void rha::AxiStreamDma::dmaAck() {
     if (fd_ >= 0) axisReadAck(fd_);
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rha::AxiStreamDma::threads() {
+    return threadSet_;
+}
+
 //! Generate a buffer. Called from master
 ris::FramePtr rha::AxiStreamDma::acceptReq(uint32_t size, bool zeroCopyEn) {
     int32_t res;
@@ -304,6 +490,7 @@ ris::FramePtr rha::AxiStreamDma::acceptReq(uint32_t size, bool zeroCopyEn) {
                 tout = timeout_;
 
                 if (select(fd_ + 1, NULL, &fds, NULL, &tout) <= 0) {
+                    txTimeoutCnt_->inc();
                     log_->critical("AxiStreamDma::acceptReq: Timeout waiting for outbound buffer after %" PRIuLEAST32
                                    ".%" PRIuLEAST32 " seconds! May be caused by outbound back pressure.",
                                    timeout_.tv_sec,
@@ -327,14 +514,56 @@ ris::FramePtr rha::AxiStreamDma::acceptReq(uint32_t size, bool zeroCopyEn) {
 
 //! Accept a frame from master
 void rha::AxiStreamDma::acceptFrame(ris::FramePtr frame) {
-    int32_t res;
-    fd_set fds;
-    struct timeval tout;
+    if (!txEn_) {
+        txFrame(frame);
+        return;
+    }
+
+    rogue::GilRelease noGil;
+
+    // Queue is full, drop or wait for room
+    if (txDrop_ && txQueue_.full()) {
+        txDropCnt_->inc();
+        return;
+    }
+    txQueue_.push(frame);
+}
+
+//! Transmit thread background
+void rha::AxiStreamDma::runTxThread() {
+    std::vector<ris::FramePtr> frames;
+    std::vector<ris::FramePtr>::iterator it;
+
+    log_->logThreadId();
+
+    frames.reserve(TxBatchCount);
+
+    // Returns zero once the queue is stopped
+    while (txQueue_.popN(frames, TxBatchCount) > 0) {
+        for (it = frames.begin(); it != frames.end(); ++it) {
+            try {
+                txFrame(*it);
+            } catch (rogue::GeneralError& e) {
+                log_->error("%s", e.what());
+            }
+        }
+        frames.clear();
+    }
+}
+
+//! Write a frame to the driver
+void rha::AxiStreamDma::txFrame(ris::FramePtr frame) {
+    std::vector<ris::BufferPtr> buffs;
     uint32_t meta;
     uint32_t fuser;
     uint32_t luser;
-    uint32_t cont;
+    uint32_t flags;
+    uint32_t count;
+    uint32_t x;
+    ssize_t res;
     bool emptyFrame;
+    bool ready;
+    bool error;
 
     rogue::GilRelease noGil;
     ris::FrameLockPtr lock = frame->lock();
@@ -346,121 +575,125 @@ void rha::AxiStreamDma::acceptFrame(ris::FramePtr frame) {
         return;
     }
 
-    // Go through each (*it)er in the frame
+    buffs.reserve(frame->bufferCount());
+
+    // Collect the buffers to write
     ris::Frame::BufferIterator it;
     for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it) {
         (*it)->zeroHeader();
 
-        // First buffer
-        if (it == frame->beginBuffer()) {
-            fuser = frame->getFirstUser();
-            if (enSsi_) fuser |= 0x2;
-        } else {
-            fuser = 0;
-        }
-
-        // Last Buffer
-        if (it == (frame->endBuffer() - 1)) {
-            cont  = 0;
-            luser = frame->getLastUser();
-
-            // Continue flag is set if this is not the last (*it)er
-        } else {
-            cont  = 1;
-            luser = 0;
-        }
-
-        // Get (*it)er meta field
+        // Get buffer meta field
         meta = (*it)->getMeta();
 
         // Meta is zero copy as indicated by bit 31
         if ((meta & 0x80000000) != 0) {
             emptyFrame = true;
 
-            // Buffer is not already stale as indicates by bit 30
-            if ((meta & 0x40000000) == 0) {
-                // Write by passing (*it)er index to driver
-                if (dmaWriteIndex(fd_,
-                                  meta & 0x3FFFFFFF,
-                                  (*it)->getPayload(),
-                                  axisSetFlags(fuser, luser, cont),
-                                  dest_) <= 0) {
-                    throw(rogue::GeneralError("AxiStreamDma::acceptFrame", "AXIS Write Call Failed"));
-                }
+            // Buffer is already stale as indicated by bit 30
+            if ((meta & 0x40000000) != 0) continue;
+        }
+        buffs.push_back(*it);
+    }
+
+    count = buffs.size();
+    fuser = frame->getFirstUser();
+    luser = frame->getLastUser();
+    if (enSsi_) fuser |= 0x2;
+    ready = false;
+    error = false;
+
+    for (x = 0; x < count; x++) {
+        meta = buffs[x]->getMeta();
+
+        // Continue flag is set on all but the last buffer of the frame
+        flags = axisSetFlags((x == 0) ? fuser : 0, (x == count - 1) ? luser : 0, (x == count - 1) ? 0 : 1);
 
-                // Mark (*it)er as stale
-                meta |= 0x40000000;
-                (*it)->setMeta(meta);
+        // Write by passing buffer index to driver
+        if ((meta & 0x80000000) != 0) {
+            if (dmaWriteIndex(fd_, meta & 0x3FFFFFFF, buffs[x]->getPayload(), flags, dest_) <= 0) {
+                error = true;
+                break;
             }
 
-            // Write to pgp with (*it)er copy in driver
-        } else {
-            // Keep trying since select call can fire
-            // but write fails because we did not win the (*it)er lock
-            do {
-                // Setup fds for select call
-                FD_ZERO(&fds);
-                FD_SET(fd_, &fds);
+            // Mark buffer as stale, it now belongs to the driver
+            buffs[x]->setMeta(meta | 0x40000000);
+            ready = false;
 
-                // Setup select timeout
-                tout = timeout_;
+            // Write with buffer copy in driver
+        } else {
+            // Select is called once per run of copy buffers and again when a write is not accepted
+            res = 0;
+            while (ready || (ready = txWait())) {
+                if ((res = dmaWrite(fd_, buffs[x]->begin(), buffs[x]->getPayload(), flags, dest_)) != 0) break;
+                ready = false;
+            }
 
-                if (select(fd_ + 1, NULL, &fds, NULL, &tout) <= 0) {
-                    log_->critical("AxiStreamDma::acceptFrame: Timeout waiting for outbound write after %" PRIuLEAST32
-                                   ".%" PRIuLEAST32 " seconds! May be caused by outbound back pressure.",
-                                   timeout_.tv_sec,
-                                   timeout_.tv_usec);
-                    res = 0;
-                } else {
-                    // Write with (*it)er copy
-                    if ((res =
-                             dmaWrite(fd_, (*it)->begin(), (*it)->getPayload(), axisSetFlags(fuser, luser, 0), dest_)) <
-                        0) {
-                        throw(rogue::GeneralError("AxiStreamDma::acceptFrame", "AXIS Write Call Failed!!!!"));
-                    }
-                }
-            } while (res == 0);  // Exit out if return flag was set false
+            if (res < 0) error = true;
+            if (res <= 0) break;
         }
     }
 
+    // Unsent zero copy buffers are returned to the driver
     if (emptyFrame) frame->clear();
+
+    if (error) throw(rogue::GeneralError("AxiStreamDma::acceptFrame", "AXIS Write Call Failed!!!!"));
+}
+
+//! Wait for the driver to accept a copy mode write
+bool rha::AxiStreamDma::txWait() {
+    fd_set fds;
+    struct timeval tout;
+
+    while (txRun_) {
+        // Setup fds for select call
+        FD_ZERO(&fds);
+        FD_SET(fd_, &fds);
+
+        // Setup select timeout
+        tout = timeout_;
+
+        if (select(fd_ + 1, NULL, &fds, NULL, &tout) > 0) return true;
+
+        txTimeoutCnt_->inc();
+        log_->critical("AxiStreamDma::acceptFrame: Timeout waiting for outbound write after %" PRIuLEAST32
+                       ".%" PRIuLEAST32 " seconds! May be caused by outbound back pressure.",
+                       timeout_.tv_sec,
+                       timeout_.tv_usec);
+    }
+    return false;
 }
 
 //! Return a buffer
 void rha::AxiStreamDma::retBuffer(uint8_t* data, uint32_t meta, uint32_t size) {
     rogue::GilRelease noGil;
-    uint32_t ret[100];
+    uint32_t ret[RetBufferCount];
     uint32_t count;
-    uint32_t x;
+    uint64_t now;
 
     // Buffer is zero copy as indicated by bit 31
     if ((meta & 0x80000000) != 0) {
         // Device is open and buffer is not stale
         // Bit 30 indicates buffer has already been returned to hardware
         if ((fd_ >= 0) && ((meta & 0x40000000) == 0)) {
-#if 0
-         // Add to queue
-         printf("Adding to queue\n");
-         retQueue_.push(meta);
+            count = 0;
+            now   = rogue::monotonicNs();
 
-         // Bulk return
-         if ( (count = retQueue_.size()) >= retThold_ ) {
-            printf("Return count=%" PRIu32 "\n", count);
-            if ( count > 100 ) count = 100;
-            for (x=0; x < count; x++) ret[x] = retQueue_.pop() & 0x3FFFFFFF;
+            {
+                std::lock_guard<std::mutex> lock(retMtx_);
 
-            if ( dmaRetIndexes(fd_, count, ret) < 0 )
-               throw(rogue::GeneralError("AxiStreamDma::retBuffer", "AXIS Return Buffer Call Failed!!!!"));
+                if (retCount_ == 0) retFirst_ = now;
+                retQueue_[retCount_++] = meta & 0x3FFFFFFF;
 
-            decCounter(size*count);
-            printf("Return done\n");
-         }
-
-#else
-            if (dmaRetIndex(fd_, meta & 0x3FFFFFFF) < 0)
-                throw(rogue::GeneralError("AxiStreamDma::retBuffer", "AXIS Return Buffer Call Failed!!!!"));
+                // Return the batch once full or once the oldest buffer has been held too long
+                if (retCount_ >= retThold_ || (now - retFirst_) >= (retTime_ * 1000ULL)) {
+                    if (retCount_ < retThold_) retTimeCnt_->inc();
+                    count = retCount_;
+                    memcpy(ret, retQueue_, count * sizeof(uint32_t));
+                    retCount_ = 0;
+                }
+            }
 
-#endif
+            if (count > 0) retIndexes(ret, count);
         }
         decCounter(size);
 
@@ -470,8 +703,136 @@ void rha::AxiStreamDma::retBuffer(uint8_t* data, uint32_t meta, uint32_t size) {
     }
 }
 
+//! Return held buffers
+void rha::AxiStreamDma::retFlush(bool all) {
+    uint32_t ret[RetBufferCount];
+    uint32_t count;
+
+    {
+        std::lock_guard<std::mutex> lock(retMtx_);
+
+        if (retCount_ == 0) return;
+        if ((!all) && (rogue::monotonicNs() - retFirst_) < (retTime_ * 1000ULL)) return;
+        if (!all) retTimeCnt_->inc();
+
+        count = retCount_;
+        memcpy(ret, retQueue_, count * sizeof(uint32_t));
+        retCount_ = 0;
+    }
+
+    if (fd_ >= 0) retIndexes(ret, count);
+}
+
+//! Return a list of buffer indexes to the driver
+void rha::AxiStreamDma::retIndexes(uint32_t* indexes, uint32_t count) {
+    ssize_t res;
+
+    if (count == 1)
+        res = dmaRetIndex(fd_, indexes[0]);
+    else
+        res = dmaRetIndexes(fd_, count, indexes);
+
+    if (res < 0) throw(rogue::GeneralError("AxiStreamDma::retBuffer", "AXIS Return Buffer Call Failed!!!!"));
+
+    retBatchCnt_->inc();
+    retBuffCnt_->inc(count);
+}
+
+//! Return timer expiration from the reactor
+void rha::AxiStreamDma::retTimer() {
+    uint64_t exp;
+
+    // Drain the expiration count before the timer is re-armed
+    while (::read(retTimerFd_, &exp, sizeof(exp)) > 0) continue;
+
+    retFlush(false);
+}
+
+//! Set the period of the return timer to the hold time
+void rha::AxiStreamDma::retTimerSet() {
+    struct itimerspec spec;
+
+    spec.it_interval.tv_sec  = retTime_ / 1000000;
+    spec.it_interval.tv_nsec = (retTime_ % 1000000) * 1000;
+    spec.it_value            = spec.it_interval;
+
+    timerfd_settime(retTimerFd_, 0, &spec, NULL);
+}
+
 //! Run thread
 void rha::AxiStreamDma::runThread(std::weak_ptr<int> lockPtr) {
+    std::vector<ris::FramePtr> frames;
+    fd_set fds;
+    struct timeval tout;
+    uint64_t start;
+    uint64_t last;
+    uint64_t busy;
+    int32_t res;
+
+    // Wait until constructor completes
+    while (!lockPtr.expired()) continue;
+
+    log_->logThreadId();
+
+    frames.reserve(RxBufferCount);
+
+    last = 0;
+
+    while (threadEn_) {
+        busy  = static_cast<uint64_t>(busyPoll_) * 1000ULL;
+        start = rogue::monotonicNs();
+
+        // Poll the driver without sleeping for the busy poll time after the last buffer
+        if ((busy != 0) && ((start - last) < busy)) {
+            if ((res = rxRead(frames)) > 0) {
+                pollCnt_->inc();
+                last = rogue::monotonicNs();
+            } else {
+                pollTime_->inc(rogue::monotonicNs() - start);
+            }
+        } else {
+            // Setup fds for select call
+            FD_ZERO(&fds);
+            FD_SET(fd_, &fds);
+
+            // Setup select timeout
+            tout.tv_sec  = 0;
+            tout.tv_usec = 1000;
+
+            // Select returns with available buffer
+            res = select(fd_ + 1, &fds, NULL, NULL, &tout);
+            blockTime_->inc(rogue::monotonicNs() - start);
+
+            if (res > 0 && rxRead(frames) > 0) last = rogue::monotonicNs();
+        }
+
+        // Forward all frames completed by this read as a batch
+        if (!frames.empty()) {
+            sendFrames(frames);
+            frames.clear();
+        }
+
+        // Return buffers which have been held for the maximum time
+        retFlush(false);
+    }
+}
+
+//! Receive from the reactor, read until the driver has no more buffers
+void rha::AxiStreamDma::rxReady() {
+    std::vector<ris::FramePtr> frames;
+
+    frames.reserve(RxBufferCount);
+
+    while (rxRead(frames) > 0) {
+        if (!frames.empty()) {
+            sendFrames(frames);
+            frames.clear();
+        }
+    }
+}
+
+//! Read available buffers and assemble frames
+int32_t rha::AxiStreamDma::rxRead(std::vector<ris::FramePtr>& frames) {
     ris::BufferPtr buff[RxBufferCount];
     uint32_t meta[RxBufferCount];
     uint32_t rxFlags[RxBufferCount];
@@ -479,96 +840,76 @@ void rha::AxiStreamDma::runThread(std::weak_ptr<int> lockPtr) {
     int32_t rxSize[RxBufferCount];
     int32_t rxCount;
     int32_t x;
-    ris::FramePtr frame;
-    fd_set fds;
     uint8_t error;
     uint32_t fuser;
     uint32_t luser;
     uint32_t cont;
-    struct timeval tout;
-
-    fuser = 0;
-    luser = 0;
-    cont  = 0;
+    uint64_t now;
 
-    // Wait until constructor completes
-    while (!lockPtr.expired()) continue;
-
-    log_->logThreadId();
+    // Zero copy buffers were not allocated
+    if (desc_->rawBuff == NULL) {
+        // Allocate a buffer
+        buff[0] = allocBuffer(desc_->bSize, NULL);
 
-    // Preallocate empty frame
-    frame = ris::Frame::create();
+        // Attempt read, dest is not needed since only one lane/vc is open
+        rxSize[0] = dmaRead(fd_, buff[0]->begin(), buff[0]->getAvailable(), rxFlags, rxError, NULL);
+        if (rxSize[0] <= 0)
+            rxCount = rxSize[0];
+        else
+            rxCount = 1;
 
-    while (threadEn_) {
-        // Setup fds for select call
-        FD_ZERO(&fds);
-        FD_SET(fd_, &fds);
+        // Zero copy read
+    } else {
+        // Attempt read, dest is not needed since only one lane/vc is open
+        rxCount = dmaReadBulkIndex(fd_, RxBufferCount, rxSize, meta, rxFlags, rxError, NULL);
 
-        // Setup select timeout
-        tout.tv_sec  = 0;
-        tout.tv_usec = 1000;
-
-        // Select returns with available buffer
-        if (select(fd_ + 1, &fds, NULL, NULL, &tout) > 0) {
-            // Zero copy buffers were not allocated
-            if (desc_->rawBuff == NULL) {
-                // Allocate a buffer
-                buff[0] = allocBuffer(desc_->bSize, NULL);
-
-                // Attempt read, dest is not needed since only one lane/vc is open
-                rxSize[0] = dmaRead(fd_, buff[0]->begin(), buff[0]->getAvailable(), rxFlags, rxError, NULL);
-                if (rxSize[0] <= 0)
-                    rxCount = rxSize[0];
-                else
-                    rxCount = 1;
-
-                // Zero copy read
-            } else {
-                // Attempt read, dest is not needed since only one lane/vc is open
-                rxCount = dmaReadBulkIndex(fd_, RxBufferCount, rxSize, meta, rxFlags, rxError, NULL);
+        // Allocate a buffer, Mark zero copy meta with bit 31 set, lower bits are index
+        for (x = 0; x < rxCount; x++)
+            buff[x] = createBuffer(desc_->rawBuff[meta[x]], 0x80000000 | meta[x], desc_->bSize, desc_->bSize);
+    }
 
-                // Allocate a buffer, Mark zero copy meta with bit 31 set, lower bits are index
-                for (x = 0; x < rxCount; x++)
-                    buff[x] = createBuffer(desc_->rawBuff[meta[x]], 0x80000000 | meta[x], desc_->bSize, desc_->bSize);
-            }
+    // Return of -1 is bad
+    if (rxCount < 0) throw(rogue::GeneralError("AxiStreamDma::rxRead", "DMA Interface Failure!"));
 
-            // Return of -1 is bad
-            if (rxCount < 0) throw(rogue::GeneralError("AxiStreamDma::runThread", "DMA Interface Failure!"));
+    // Ingress time for frames started by this read
+    now = rogue::monotonicNs();
 
-            // Read was successful
-            for (x = 0; x < rxCount; x++) {
-                fuser = axisGetFuser(rxFlags[x]);
-                luser = axisGetLuser(rxFlags[x]);
-                cont  = axisGetCont(rxFlags[x]);
+    // Read was successful
+    for (x = 0; x < rxCount; x++) {
+        fuser = axisGetFuser(rxFlags[x]);
+        luser = axisGetLuser(rxFlags[x]);
+        cont  = axisGetCont(rxFlags[x]);
 
-                buff[x]->setPayload(rxSize[x]);
+        buff[x]->setPayload(rxSize[x]);
 
-                error = frame->getError();
+        error = rxFrame_->getError();
 
-                // Receive error
-                error |= (rxError[x] & 0xFF);
+        // Receive error
+        error |= (rxError[x] & 0xFF);
 
-                // First buffer of frame
-                if (frame->isEmpty()) frame->setFirstUser(fuser & 0xFF);
+        // First buffer of frame
+        if (rxFrame_->isEmpty()) {
+            rxFrame_->setFirstUser(fuser & 0xFF);
+            rxFrame_->setTimestamp(now);
+        }
 
-                // Last buffer of frame
-                if (cont == 0) {
-                    frame->setLastUser(luser & 0xFF);
-                    if (enSsi_ && ((luser & 0x1) != 0)) error |= 0x80;
-                }
+        // Last buffer of frame
+        if (cont == 0) {
+            rxFrame_->setLastUser(luser & 0xFF);
+            if (enSsi_ && ((luser & 0x1) != 0)) error |= 0x80;
+        }
 
-                frame->setError(error);
-                frame->appendBuffer(buff[x]);
-                buff[x].reset();
+        rxFrame_->setError(error);
+        rxFrame_->appendBuffer(buff[x]);
+        buff[x].reset();
 
-                // If continue flag is not set, push frame and get a new empty frame
-                if (cont == 0) {
-                    sendFrame(frame);
-                    frame = ris::Frame::create();
-                }
-            }
+        // If continue flag is not set, queue frame and get a new empty frame
+        if (cont == 0) {
+            frames.push_back(rxFrame_);
+            rxFrame_ = ris::Frame::create();
         }
     }
+    return rxCount;
 }
 
 //! Get the DMA Driver's Git Version
@@ -654,6 +995,21 @@ void rha::AxiStreamDma::setup_python() {
         bp::init<std::string, uint32_t, bool>())
         .def("setDriverDebug", &rha::AxiStreamDma::setDriverDebug)
         .def("dmaAck", &rha::AxiStreamDma::dmaAck)
+        .def("threads", &rha::AxiStreamDma::threads)
+        .def("setReactor", &rha::AxiStreamDma::setReactor)
+        .def("setRetBatch", &rha::AxiStreamDma::setRetBatch)
+        .def("getRetBatchCount", &rha::AxiStreamDma::getRetBatchCount)
+        .def("getRetBuffCount", &rha::AxiStreamDma::getRetBuffCount)
+        .def("getRetTimeoutCount", &rha::AxiStreamDma::getRetTimeoutCount)
+        .def("setBusyPoll", &rha::AxiStreamDma::setBusyPoll)
+        .def("getBusyPoll", &rha::AxiStreamDma::getBusyPoll)
+        .def("getBusyPollCount", &rha::AxiStreamDma::getBusyPollCount)
+        .def("getBusyPollTime", &rha::AxiStreamDma::getBusyPollTime)
+        .def("getBlockTime", &rha::AxiStreamDma::getBlockTime)
+        .def("setTxQueue", &rha::AxiStreamDma::setTxQueue)
+        .def("getTxQueueDepth", &rha::AxiStreamDma::getTxQueueDepth)
+        .def("getTxDropCount", &rha::AxiStreamDma::getTxDropCount)
+        .def("getTxTimeoutCount", &rha::AxiStreamDma::getTxTimeoutCount)
         .def("setTimeout", &rha::AxiStreamDma::setTimeout)
         .def("getGitVersion", &rha::AxiStreamDma::getGitVersion)
         .def("getApiVersion", &rha::AxiStreamDma::getApiVersion)
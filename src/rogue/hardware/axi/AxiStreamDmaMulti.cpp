@@ -0,0 +1,340 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Class for receiving multiple destinations from the AxiStreamDma Driver.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/hardware/axi/AxiStreamDmaMulti.h"
+
+#include <inttypes.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Histogram.h"
+#include "rogue/Threads.h"
+#include "rogue/hardware/drivers/AxisDriver.h"
+#include "rogue/interfaces/stream/Buffer.h"
+#include "rogue/interfaces/stream/Fifo.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+
+namespace rha = rogue::hardware::axi;
+namespace ris = rogue::interfaces::stream;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+rha::AxiStreamDmaMultiPtr rha::AxiStreamDmaMulti::create(std::string path,
+                                                         const std::vector<uint32_t>& dests,
+                                                         bool ssiEnable,
+                                                         uint32_t fifoDepth) {
+    rha::AxiStreamDmaMultiPtr r = std::make_shared<rha::AxiStreamDmaMulti>(path, dests, ssiEnable, fifoDepth);
+    return (r);
+}
+
+#ifndef NO_PYTHON
+
+//! Python class creation, destinations are passed as a list
+rha::AxiStreamDmaMultiPtr rha::AxiStreamDmaMulti::createPy(std::string path,
+                                                           bp::object dests,
+                                                           bool ssiEnable,
+                                                           uint32_t fifoDepth) {
+    std::vector<uint32_t> list;
+    uint32_t x;
+
+    for (x = 0; x < bp::len(dests); x++) list.push_back(bp::extract<uint32_t>(dests[x]));
+    return create(path, list, ssiEnable, fifoDepth);
+}
+
+#endif
+
+//! Open the device for the passed destinations
+rha::AxiStreamDmaMulti::AxiStreamDmaMulti(std::string path,
+                                          const std::vector<uint32_t>& dests,
+                                          bool ssiEnable,
+                                          uint32_t fifoDepth) {
+    std::vector<uint32_t>::const_iterator it;
+    std::shared_ptr<Dest> dest;
+    uint8_t mask[DMA_MASK_SIZE];
+
+    enSsi_    = ssiEnable;
+    threadEn_ = false;
+    thread_   = NULL;
+    table_.resize(DestCount, NULL);
+
+    log_       = rogue::Logging::create("axi.AxiStreamDmaMulti");
+    threadSet_ = rogue::ThreadSet::create("axi.AxiStreamDmaMulti");
+
+    metrics_      = rogue::MetricSet::create("axi.AxiStreamDmaMulti");
+    unmatchedCnt_ = metrics_->counter("unmatchedCount");
+
+    // Create the outputs and the destination mask
+    dmaInitMaskBytes(mask);
+
+    for (it = dests.begin(); it != dests.end(); ++it) {
+        if (*it >= DestCount || table_[*it] != NULL)
+            throw(rogue::GeneralError::create("AxiStreamDmaMulti::AxiStreamDmaMulti",
+                                              "Invalid or duplicate destination 0x%" PRIx32,
+                                              *it));
+
+        dest         = std::make_shared<Dest>();
+        dest->master = ris::Master::create();
+        dest->frame  = ris::Frame::create();
+        dest->frames.reserve(RxBufferCount);
+
+        if (fifoDepth > 0) {
+            dest->fifo = ris::Fifo::create(fifoDepth, 0, true);
+            dest->master->addSlave(dest->fifo);
+        }
+
+        dests_.push_back(dest);
+        table_[*it] = dest.get();
+        dmaAddMaskBytes(mask, *it);
+    }
+
+    rogue::GilRelease noGil;
+
+    // Attempt to open shared structure
+    desc_ = rha::AxiStreamDma::openShared(path, log_);
+
+    // Open non shared file descriptor
+    if ((fd_ = ::open(path.c_str(), O_RDWR)) < 0) {
+        rha::AxiStreamDma::closeShared(desc_);
+        throw(rogue::GeneralError::create("AxiStreamDmaMulti::AxiStreamDmaMulti",
+                                          "Failed to open device file: %s",
+                                          path.c_str()));
+    }
+
+    // Zero copy is disabled
+    if (desc_->rawBuff == NULL) {
+        desc_->bCount = dmaGetTxBuffCount(fd_) + dmaGetRxBuffCount(fd_);
+        desc_->bSize  = dmaGetBuffSize(fd_);
+    }
+
+    if (dmaSetMaskBytes(fd_, mask) < 0) {
+        rha::AxiStreamDma::closeShared(desc_);
+        ::close(fd_);
+        throw(rogue::GeneralError::create("AxiStreamDmaMulti::AxiStreamDmaMulti",
+                                          "Failed to open device file %s with the destination mask! "
+                                          "Another process may already have one of the destinations open!",
+                                          path.c_str()));
+    }
+
+    // Start read thread
+    threadEn_ = true;
+    thread_   = threadSet_->start("AxiStreamDmaMulti", std::bind(&rha::AxiStreamDmaMulti::runThread, this));
+}
+
+//! Close the device
+rha::AxiStreamDmaMulti::~AxiStreamDmaMulti() {
+    this->stop();
+}
+
+//! Stop the interface
+void rha::AxiStreamDmaMulti::stop() {
+    if (threadEn_) {
+        rogue::GilRelease noGil;
+
+        threadEn_ = false;
+        thread_->join();
+        delete thread_;
+        thread_ = NULL;
+
+        rha::AxiStreamDma::closeShared(desc_);
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+//! Get the output of a destination
+ris::MasterPtr rha::AxiStreamDmaMulti::output(uint32_t dest) {
+    if (dest >= DestCount || table_[dest] == NULL)
+        throw(rogue::GeneralError::create("AxiStreamDmaMulti::output", "Destination 0x%" PRIx32 " is not open", dest));
+
+    if (table_[dest]->fifo) return table_[dest]->fifo;
+    return table_[dest]->master;
+}
+
+//! Get the number of buffers received for destinations which are not in the list
+uint64_t rha::AxiStreamDmaMulti::getUnmatchedCount() {
+    return unmatchedCnt_->get();
+}
+
+//! Get the thread set
+rogue::ThreadSetPtr rha::AxiStreamDmaMulti::threads() {
+    return threadSet_;
+}
+
+//! Return a buffer
+void rha::AxiStreamDmaMulti::retBuffer(uint8_t* data, uint32_t meta, uint32_t size) {
+    rogue::GilRelease noGil;
+
+    // Buffer is zero copy as indicated by bit 31
+    if ((meta & 0x80000000) != 0) {
+        // Device is open, received buffers are never stale
+        if (fd_ >= 0) {
+            if (dmaRetIndex(fd_, meta & 0x3FFFFFFF) < 0)
+                throw(rogue::GeneralError("AxiStreamDmaMulti::retBuffer", "AXIS Return Buffer Call Failed!!!!"));
+        }
+        decCounter(size);
+
+        // Buffer is allocated from Pool class
+    } else {
+        Pool::retBuffer(data, meta, size);
+    }
+}
+
+//! Run thread
+void rha::AxiStreamDmaMulti::runThread() {
+    fd_set fds;
+    struct timeval tout;
+
+    log_->logThreadId();
+
+    while (threadEn_) {
+        // Setup fds for select call
+        FD_ZERO(&fds);
+        FD_SET(fd_, &fds);
+
+        // Setup select timeout
+        tout.tv_sec  = 0;
+        tout.tv_usec = 1000;
+
+        // Select returns with available buffer
+        if (select(fd_ + 1, &fds, NULL, NULL, &tout) > 0) rxRead();
+    }
+}
+
+//! Read available buffers and pass completed frames to the outputs
+void rha::AxiStreamDmaMulti::rxRead() {
+    ris::BufferPtr buff[RxBufferCount];
+    uint32_t meta[RxBufferCount];
+    uint32_t rxFlags[RxBufferCount];
+    uint32_t rxError[RxBufferCount];
+    uint32_t rxDest[RxBufferCount];
+    int32_t rxSize[RxBufferCount];
+    std::vector<Dest*> touched;
+    std::vector<Dest*>::iterator it;
+    int32_t rxCount;
+    int32_t x;
+    Dest* dest;
+    uint8_t error;
+    uint32_t fuser;
+    uint32_t luser;
+    uint32_t cont;
+    uint64_t now;
+
+    // Zero copy buffers were not allocated
+    if (desc_->rawBuff == NULL) {
+        // Allocate a buffer
+        buff[0] = allocBuffer(desc_->bSize, NULL);
+
+        // Attempt read
+        rxSize[0] = dmaRead(fd_, buff[0]->begin(), buff[0]->getAvailable(), rxFlags, rxError, rxDest);
+        if (rxSize[0] <= 0)
+            rxCount = rxSize[0];
+        else
+            rxCount = 1;
+
+        // Zero copy read
+    } else {
+        rxCount = dmaReadBulkIndex(fd_, RxBufferCount, rxSize, meta, rxFlags, rxError, rxDest);
+
+        // Allocate a buffer, Mark zero copy meta with bit 31 set, lower bits are index
+        for (x = 0; x < rxCount; x++)
+            buff[x] = createBuffer(desc_->rawBuff[meta[x]], 0x80000000 | meta[x], desc_->bSize, desc_->bSize);
+    }
+
+    // Return of -1 is bad
+    if (rxCount < 0) throw(rogue::GeneralError("AxiStreamDmaMulti::rxRead", "DMA Interface Failure!"));
+
+    // Ingress time for frames started by this read
+    now = rogue::monotonicNs();
+
+    for (x = 0; x < rxCount; x++) {
+        dest = (rxDest[x] < DestCount) ? table_[rxDest[x]] : NULL;
+
+        // Releasing the buffer returns it to the driver
+        if (dest == NULL) {
+            unmatchedCnt_->inc();
+            buff[x].reset();
+            continue;
+        }
+
+        fuser = axisGetFuser(rxFlags[x]);
+        luser = axisGetLuser(rxFlags[x]);
+        cont  = axisGetCont(rxFlags[x]);
+
+        buff[x]->setPayload(rxSize[x]);
+
+        error = dest->frame->getError();
+
+        // Receive error
+        error |= (rxError[x] & 0xFF);
+
+        // First buffer of frame
+        if (dest->frame->isEmpty()) {
+            dest->frame->setFirstUser(fuser & 0xFF);
+            dest->frame->setTimestamp(now);
+        }
+
+        // Last buffer of frame
+        if (cont == 0) {
+            dest->frame->setLastUser(luser & 0xFF);
+            if (enSsi_ && ((luser & 0x1) != 0)) error |= 0x80;
+        }
+
+        dest->frame->setError(error);
+        dest->frame->appendBuffer(buff[x]);
+        buff[x].reset();
+
+        // If continue flag is not set, queue frame and get a new empty frame
+        if (cont == 0) {
+            if (dest->frames.empty()) touched.push_back(dest);
+            dest->frames.push_back(dest->frame);
+            dest->frame = ris::Frame::create();
+        }
+    }
+
+    // Forward the frames completed by this read as a batch per destination
+    for (it = touched.begin(); it != touched.end(); ++it) {
+        (*it)->master->sendFrames((*it)->frames);
+        (*it)->frames.clear();
+    }
+}
+
+void rha::AxiStreamDmaMulti::setup_python() {
+#ifndef NO_PYTHON
+
+    bp::class_<rha::AxiStreamDmaMulti, rha::AxiStreamDmaMultiPtr, bp::bases<ris::Pool>, boost::noncopyable>(
+        "AxiStreamDmaMulti",
+        bp::no_init)
+        .def("__init__", bp::make_constructor(&rha::AxiStreamDmaMulti::createPy))
+        .def("output", &rha::AxiStreamDmaMulti::output)
+        .def("getUnmatchedCount", &rha::AxiStreamDmaMulti::getUnmatchedCount)
+        .def("threads", &rha::AxiStreamDmaMulti::threads)
+        .def("_stop", &rha::AxiStreamDmaMulti::stop);
+
+    bp::implicitly_convertible<rha::AxiStreamDmaMultiPtr, ris::PoolPtr>();
+#endif
+}
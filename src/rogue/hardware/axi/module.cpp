@@ -23,6 +23,7 @@
 
 #include "rogue/hardware/axi/AxiMemMap.h"
 #include "rogue/hardware/axi/AxiStreamDma.h"
+#include "rogue/hardware/axi/AxiStreamDmaMulti.h"
 
 namespace bp  = boost::python;
 namespace rha = rogue::hardware::axi;
@@ -39,5 +40,6 @@ void rha::setup_module() {
     bp::scope io_scope = module;
 
     rha::AxiStreamDma::setup_python();
+    rha::AxiStreamDmaMulti::setup_python();
     rha::AxiMemMap::setup_python();
 }
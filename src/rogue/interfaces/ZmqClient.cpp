@@ -23,12 +23,14 @@
 #include <zmq.h>
 
 #include <cstdio>
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/ScopedGil.h"
+#include "rogue/Threads.h"
 
 #ifndef NO_PYTHON
     #include <boost/python.hpp>
@@ -54,6 +56,7 @@ void rogue::interfaces::ZmqClient::setup_python() {
         .def("setDisp", &rogue::interfaces::ZmqClient::setDisp)
         .def("exec", &rogue::interfaces::ZmqClient::exec)
         .def("valueDisp", &rogue::interfaces::ZmqClient::valueDisp)
+        .def("threads", &rogue::interfaces::ZmqClient::threads)
         .def("_stop", &rogue::interfaces::ZmqClient::stop);
 #endif
 }
@@ -68,7 +71,8 @@ rogue::interfaces::ZmqClient::ZmqClient(const std::string& addr, uint16_t port,
     this->zmqSub_   = zmq_socket(this->zmqCtx_, ZMQ_SUB);
     this->zmqReq_   = zmq_socket(this->zmqCtx_, ZMQ_REQ);
 
-    log_ = rogue::Logging::create("ZmqClient");
+    log_       = rogue::Logging::create("ZmqClient");
+    threadSet_ = rogue::ThreadSet::create("ZmqClient");
 
     if (!doString_) {
         // Setup sub port
@@ -130,7 +134,7 @@ rogue::interfaces::ZmqClient::ZmqClient(const std::string& addr, uint16_t port,
         log_->info("Connected to Rogue server at ports %" PRIu16 ":%" PRIu32, port, reqPort);
 
         threadEn_ = true;
-        thread_   = new std::thread(&rogue::interfaces::ZmqClient::runThread, this);
+        thread_   = threadSet_->start("ZmqClient", std::bind(&rogue::interfaces::ZmqClient::runThread, this));
     }
     running_ = true;
 }
@@ -166,6 +170,10 @@ void rogue::interfaces::ZmqClient::setTimeout(uint32_t msecs, bool waitRetry) {
         throw(rogue::GeneralError("ZmqClient::setTimeout", "Failed to set socket timeout"));
 }
 
+rogue::ThreadSetPtr rogue::interfaces::ZmqClient::threads() {
+    return threadSet_;
+}
+
 std::string rogue::interfaces::ZmqClient::sendString(const std::string& path, const std::string& attr, const std::string& arg) {
     std::string snd;
     std::string ret;
@@ -22,12 +22,14 @@
 #include <inttypes.h>
 #include <zmq.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/ScopedGil.h"
+#include "rogue/Threads.h"
 
 #ifndef NO_PYTHON
     #include <boost/python.hpp>
@@ -50,13 +52,15 @@ void rogue::interfaces::ZmqServer::setup_python() {
         .def("_doString", &rogue::interfaces::ZmqServer::doString, &rogue::interfaces::ZmqServerWrap::defDoString)
         .def("_publish", &rogue::interfaces::ZmqServer::publish)
         .def("port", &rogue::interfaces::ZmqServer::port)
+        .def("threads", &rogue::interfaces::ZmqServer::threads)
         .def("_stop", &rogue::interfaces::ZmqServer::stop)
         .def("_start", &rogue::interfaces::ZmqServer::start);
 #endif
 }
 
 rogue::interfaces::ZmqServer::ZmqServer(const std::string& addr, uint16_t port) {
-    log_ = rogue::Logging::create("ZmqServer");
+    log_       = rogue::Logging::create("ZmqServer");
+    threadSet_ = rogue::ThreadSet::create("ZmqServer");
 
     this->addr_     = addr;
     this->zmqCtx_   = zmq_ctx_new();
@@ -102,8 +106,8 @@ void rogue::interfaces::ZmqServer::start() {
     log_->info("Started Rogue server at ports %" PRIu16 ":%" PRIu16, this->basePort_, this->basePort_ + 1);
 
     this->threadEn_ = true;
-    this->rThread_  = new std::thread(&rogue::interfaces::ZmqServer::runThread, this);
-    this->sThread_  = new std::thread(&rogue::interfaces::ZmqServer::strThread, this);
+    this->rThread_  = threadSet_->start("ZmqServer", std::bind(&rogue::interfaces::ZmqServer::runThread, this));
+    this->sThread_  = threadSet_->start("ZmqServerStr", std::bind(&rogue::interfaces::ZmqServer::strThread, this));
 
     // Send empty frame
     dummy = "null\n";
@@ -208,6 +212,10 @@ uint16_t rogue::interfaces::ZmqServer::port() {
     return this->basePort_;
 }
 
+rogue::ThreadSetPtr rogue::interfaces::ZmqServer::threads() {
+    return threadSet_;
+}
+
 std::string rogue::interfaces::ZmqServer::doString(const std::string& data) {
     return "";
 }
@@ -22,12 +22,14 @@
 #include <zmq.h>
 
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/memory/Constants.h"
 #include "rogue/interfaces/memory/Transaction.h"
 #include "rogue/interfaces/memory/TransactionLock.h"
@@ -56,6 +58,7 @@ rim::TcpClient::TcpClient(std::string addr, uint16_t port) : rim::Slave(4, 0xFFF
     logstr.append(std::to_string(port));
 
     this->bridgeLog_ = rogue::Logging::create(logstr);
+    this->threadSet_ = rogue::ThreadSet::create("memory.TcpClient");
 
     // Format address
     this->respAddr_ = "tcp://";
@@ -104,12 +107,7 @@ rim::TcpClient::TcpClient(std::string addr, uint16_t port) : rim::Slave(4, 0xFFF
 
     // Start rx thread
     threadEn_     = true;
-    this->thread_ = new std::thread(&rim::TcpClient::runThread, this);
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "TcpClient");
-#endif
+    this->thread_ = threadSet_->start("TcpClient", std::bind(&rim::TcpClient::runThread, this));
 }
 
 //! Destructor
@@ -133,6 +131,11 @@ void rim::TcpClient::stop() {
     }
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rim::TcpClient::threads() {
+    return threadSet_;
+}
+
 //! Post a transaction
 void rim::TcpClient::doTransaction(rim::TransactionPtr tran) {
     uint32_t x;
@@ -317,7 +320,8 @@ void rim::TcpClient::setup_python() {
     bp::class_<rim::TcpClient, rim::TcpClientPtr, bp::bases<rim::Slave>, boost::noncopyable>(
         "TcpClient",
         bp::init<std::string, uint16_t>())
-        .def("close", &rim::TcpClient::close);
+        .def("close", &rim::TcpClient::close)
+        .def("threads", &rim::TcpClient::threads);
 
     bp::implicitly_convertible<rim::TcpClientPtr, rim::SlavePtr>();
 #endif
@@ -22,12 +22,14 @@
 #include <zmq.h>
 
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/memory/Constants.h"
 
 namespace rim = rogue::interfaces::memory;
@@ -54,6 +56,7 @@ rim::TcpServer::TcpServer(std::string addr, uint16_t port) {
     logstr.append(std::to_string(port));
 
     this->bridgeLog_ = rogue::Logging::create(logstr);
+    this->threadSet_ = rogue::ThreadSet::create("memory.TcpServer");
 
     // Format address
     this->respAddr_ = "tcp://";
@@ -99,12 +102,7 @@ rim::TcpServer::TcpServer(std::string addr, uint16_t port) {
 
     // Start rx thread
     threadEn_     = true;
-    this->thread_ = new std::thread(&rim::TcpServer::runThread, this);
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "TcpServer");
-#endif
+    this->thread_ = threadSet_->start("TcpServer", std::bind(&rim::TcpServer::runThread, this));
 }
 
 //! Destructor
@@ -127,6 +125,11 @@ void rim::TcpServer::stop() {
     }
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rim::TcpServer::threads() {
+    return threadSet_;
+}
+
 //! Run thread
 void rim::TcpServer::runThread() {
     uint8_t* data;
@@ -234,7 +237,8 @@ void rim::TcpServer::setup_python() {
     bp::class_<rim::TcpServer, rim::TcpServerPtr, bp::bases<rim::Master>, boost::noncopyable>(
         "TcpServer",
         bp::init<std::string, uint16_t>())
-        .def("close", &rim::TcpServer::close);
+        .def("close", &rim::TcpServer::close)
+        .def("threads", &rim::TcpServer::threads);
 
     bp::implicitly_convertible<rim::TcpServerPtr, rim::MasterPtr>();
 #endif
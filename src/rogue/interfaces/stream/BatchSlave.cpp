@@ -0,0 +1,278 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Stream slave which delivers frames in batches
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/stream/BatchSlave.h"
+
+#include <stdint.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/ScopedGil.h"
+#include "rogue/Threads.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace ris = rogue::interfaces::stream;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+ris::BatchSlavePtr ris::BatchSlave::create(uint32_t maxCount, uint32_t maxTime) {
+    ris::BatchSlavePtr p = std::make_shared<ris::BatchSlave>(maxCount, maxTime);
+    return (p);
+}
+
+//! Setup class in python
+void ris::BatchSlave::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<ris::BatchSlaveWrap, ris::BatchSlaveWrapPtr, bp::bases<ris::Slave>, boost::noncopyable>(
+        "BatchSlave",
+        bp::init<uint32_t, uint32_t>())
+        .def("batchCnt", &BatchSlave::batchCnt)
+        .def("setMaxDepth", &BatchSlave::setMaxDepth)
+        .def("dropCnt", &BatchSlave::dropCnt)
+        .def("threads", &BatchSlave::threads);
+
+    bp::implicitly_convertible<ris::BatchSlaveWrapPtr, ris::BatchSlavePtr>();
+    bp::implicitly_convertible<ris::BatchSlavePtr, ris::SlavePtr>();
+#endif
+}
+
+//! Creator
+ris::BatchSlave::BatchSlave(uint32_t maxCount, uint32_t maxTime)
+    : ris::Slave(),
+      log_(rogue::Logging::create("stream.BatchSlave")),
+      maxCount_(maxCount),
+      maxTime_(maxTime),
+      maxDepth_(0),
+      drop_(false),
+      threadSet_(rogue::ThreadSet::create("stream.BatchSlave")),
+      threadEn_(true) {
+    metrics_->setPrefix("stream.BatchSlave");
+    batchCnt_ = metrics_->counter("batchCount");
+    dropCnt_  = metrics_->counter("dropCount");
+
+    thread_ = threadSet_->start("BatchSlave", std::bind(&ris::BatchSlave::runThread, this));
+}
+
+//! Deconstructor
+ris::BatchSlave::~BatchSlave() {
+    stopThread();
+}
+
+//! Stop the delivery thread
+void ris::BatchSlave::stopThread() {
+    if (thread_ == NULL) return;
+
+    // Disabled before the GIL is released, see BatchSlaveWrap::acceptBatch
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        threadEn_ = false;
+        cond_.notify_all();
+        spaceCond_.notify_all();
+    }
+
+    rogue::GilRelease noGil;
+    thread_->join();
+    delete thread_;
+    thread_ = NULL;
+}
+
+//! Get the number of delivered batches
+uint64_t ris::BatchSlave::batchCnt() {
+    return batchCnt_->get();
+}
+
+//! Limit the number of held frames
+void ris::BatchSlave::setMaxDepth(uint32_t depth, bool drop) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    maxDepth_ = depth;
+    drop_     = drop;
+    spaceCond_.notify_all();
+}
+
+//! Get the number of dropped frames
+uint64_t ris::BatchSlave::dropCnt() {
+    return dropCnt_->get();
+}
+
+//! Get the thread set
+rogue::ThreadSetPtr ris::BatchSlave::threads() {
+    return threadSet_;
+}
+
+//! Queue is at the depth limit
+bool ris::BatchSlave::full() {
+    return (maxDepth_ != 0 && queue_.size() >= maxDepth_);
+}
+
+//! Wait for space in the queue
+bool ris::BatchSlave::waitSpace(std::unique_lock<std::mutex>& lock) {
+    while (full()) {
+        if (drop_ || !threadEn_) {
+            dropCnt_->inc();
+            return false;
+        }
+
+        // The delivery thread takes a full queue without waiting for the time window
+        cond_.notify_one();
+        spaceCond_.wait(lock);
+    }
+    return true;
+}
+
+//! Accept a frame from master
+void ris::BatchSlave::acceptFrame(ris::FramePtr frame) {
+    rogue::GilRelease noGil;
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    if (!waitSpace(lock)) return;
+
+    queue_.push_back(frame);
+    if (queue_.size() == 1 || queue_.size() >= maxCount_ || full()) cond_.notify_one();
+}
+
+//! Accept a batch of frames from master
+void ris::BatchSlave::acceptFrames(std::vector<ris::FramePtr>& frames) {
+    std::vector<ris::FramePtr>::iterator it;
+
+    if (frames.empty()) return;
+
+    rogue::GilRelease noGil;
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    for (it = frames.begin(); it != frames.end(); ++it) {
+        if (waitSpace(lock)) queue_.push_back(*it);
+    }
+    cond_.notify_one();
+}
+
+//! Process a batch of frames
+void ris::BatchSlave::acceptBatch(std::vector<ris::FramePtr>& frames) {
+    for (std::vector<ris::FramePtr>::iterator it = frames.begin(); it != frames.end(); ++it)
+        ris::Slave::acceptFrame(*it);
+}
+
+//! Thread background
+void ris::BatchSlave::runThread() {
+    std::vector<ris::FramePtr> batch;
+
+    log_->logThreadId();
+
+    while (threadEn_) {
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+
+            while (threadEn_ && queue_.empty()) cond_.wait(lock);
+
+            // The time window starts with the first frame of the batch
+            std::chrono::steady_clock::time_point end =
+                std::chrono::steady_clock::now() + std::chrono::microseconds(maxTime_);
+
+            while (threadEn_ && queue_.size() < maxCount_ && !full() &&
+                   cond_.wait_until(lock, end) != std::cv_status::timeout) {
+            }
+
+            batch.swap(queue_);
+            spaceCond_.notify_all();
+        }
+
+        if (!batch.empty()) {
+            batchCnt_->inc();
+            acceptBatch(batch);
+            batch.clear();
+        }
+    }
+}
+
+#ifndef NO_PYTHON
+
+//! Create a BatchSlaveWrap object
+ris::BatchSlaveWrap::BatchSlaveWrap(uint32_t maxCount, uint32_t maxTime)
+    : ris::BatchSlave(maxCount, maxTime),
+      overrideInit_(false),
+      overrideSelf_(false) {}
+
+//! Destroy the BatchSlaveWrap
+ris::BatchSlaveWrap::~BatchSlaveWrap() {
+    // The thread calls into this class and must be stopped first
+    stopThread();
+}
+
+//! Process a batch of frames in python
+void ris::BatchSlaveWrap::acceptBatch(std::vector<ris::FramePtr>& frames) {
+    {
+        rogue::ScopedGil gil;
+
+        // The python object is being destroyed
+        if (!threadEn_) {
+            frames.clear();
+            return;
+        }
+
+        // The function is cached instead of the bound method, to avoid a reference to self
+        if (!overrideInit_) {
+            overrideInit_ = true;
+
+            if (bp::override pb = this->get_override("_acceptFrames")) {
+                overrideSelf_ = PyMethod_Check(pb.ptr());
+                override_     = overrideSelf_ ? bp::object(pb.attr("__func__")) : bp::object(pb);
+            }
+        }
+
+        if (!override_.is_none()) {
+            try {
+                bp::list lst;
+
+                for (std::vector<ris::FramePtr>::iterator it = frames.begin(); it != frames.end(); ++it)
+                    lst.append(*it);
+
+                if (overrideSelf_) {
+                    bp::object self(bp::handle<>(bp::borrowed(bp::detail::wrapper_base_::get_owner(*this))));
+                    override_(self, lst);
+                } else {
+                    override_(lst);
+                }
+            } catch (...) {
+                PyErr_Print();
+            }
+
+            // Frames created in python must be released with the GIL held
+            frames.clear();
+            return;
+        }
+    }
+    ris::BatchSlave::acceptBatch(frames);
+
+    rogue::ScopedGil gil;
+    frames.clear();
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include <memory>
 
 #include "rogue/GeneralError.h"
+#include "rogue/ObjectPool.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/Pool.h"
 
@@ -33,7 +34,38 @@ namespace ris = rogue::interfaces::stream;
  * Pass owner, raw data buffer, and meta data
  */
 ris::BufferPtr ris::Buffer::create(ris::PoolPtr source, void* data, uint32_t meta, uint32_t size, uint32_t alloc) {
-    ris::BufferPtr buff = std::make_shared<ris::Buffer>(source, data, meta, size, alloc);
+    ris::Buffer* buff;
+
+    if ((buff = static_cast<ris::Buffer*>(rogue::FreeList<ris::Buffer>::get())) != NULL) {
+        buff->init(source, data, meta, size, alloc);
+    } else {
+        rogue::objectPoolHeapCount()++;
+        buff = new ris::Buffer(source, data, meta, size, alloc);
+    }
+    return (ris::BufferPtr(buff, ris::Buffer::Recycle(), rogue::PoolAllocator<ris::Buffer>()));
+}
+
+//! Create a view of a parent buffer
+ris::BufferPtr ris::Buffer::createView(ris::BufferPtr parent, uint32_t offset, uint32_t size) {
+    ris::BufferPtr buff;
+
+    if ((static_cast<uint64_t>(offset) + size) > parent->getPayload())
+        throw(rogue::GeneralError::create("Buffer::createView",
+                                          "View at offset %" PRIu32 " with size %" PRIu32
+                                          " exceeds buffer payload %" PRIu32,
+                                          offset,
+                                          size,
+                                          parent->getPayload()));
+
+    // Views of views reference the owning buffer directly
+    while (parent->parent_) {
+        offset += parent->begin() - parent->parent_->begin();
+        parent = parent->parent_;
+    }
+
+    buff           = create(ris::PoolPtr(), parent->begin() + offset, 0, size, 0);
+    buff->parent_  = parent;
+    buff->payload_ = size;
     return (buff);
 }
 
@@ -42,6 +74,19 @@ ris::BufferPtr ris::Buffer::create(ris::PoolPtr source, void* data, uint32_t met
  * Pass owner, raw data buffer, and meta data
  */
 ris::Buffer::Buffer(ris::PoolPtr source, void* data, uint32_t meta, uint32_t size, uint32_t alloc) {
+    init(source, data, meta, size, alloc);
+}
+
+//! Destroy a buffer
+/*
+ * Owner return buffer method is called
+ */
+ris::Buffer::~Buffer() {
+    release();
+}
+
+//! Setup buffer state
+void ris::Buffer::init(ris::PoolPtr source, void* data, uint32_t meta, uint32_t size, uint32_t alloc) {
     source_    = source;
     data_      = reinterpret_cast<uint8_t*>(data);
     meta_      = meta;
@@ -52,12 +97,20 @@ ris::Buffer::Buffer(ris::PoolPtr source, void* data, uint32_t meta, uint32_t siz
     payload_   = 0;
 }
 
-//! Destroy a buffer
-/*
- * Owner return buffer method is called
- */
-ris::Buffer::~Buffer() {
-    source_->retBuffer(data_, meta_, allocSize_);
+//! Return data to the source pool
+void ris::Buffer::release() {
+    if (source_) {
+        source_->retBuffer(data_, meta_, allocSize_);
+        source_.reset();
+    }
+    parent_.reset();
+    frame_.reset();
+}
+
+//! Return a released buffer to the free list
+void ris::Buffer::Recycle::operator()(ris::Buffer* buff) const {
+    buff->release();
+    rogue::FreeList<ris::Buffer>::put(buff);
 }
 
 //! Set container frame
@@ -0,0 +1,167 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Stream channel demultiplexer
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/stream/Demux.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace ris = rogue::interfaces::stream;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+ris::DemuxPtr ris::Demux::create() {
+    ris::DemuxPtr p = std::make_shared<ris::Demux>();
+    return (p);
+}
+
+//! Setup class in python
+void ris::Demux::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<ris::Demux, ris::DemuxPtr, bp::bases<ris::Slave>, boost::noncopyable>("Demux", bp::init<>())
+        .def("output", &ris::Demux::output)
+        .def("setDropErrors", &ris::Demux::setDropErrors)
+        .def("dropCnt", &ris::Demux::dropCnt)
+        .def("unmatchedCnt", &ris::Demux::unmatchedCnt);
+
+    bp::implicitly_convertible<ris::DemuxPtr, ris::SlavePtr>();
+#endif
+}
+
+//! Creator
+ris::Demux::Demux() : ris::Slave() {
+    uint32_t x;
+
+    log_ = rogue::Logging::create("stream.Demux");
+
+    metrics_->setPrefix("stream.Demux");
+    unmatchedCnt_ = metrics_->counter("unmatchedCount");
+
+    for (x = 0; x < 256; x++) table_[x] = NULL;
+}
+
+//! Deconstructor
+ris::Demux::~Demux() {}
+
+//! Get the output for a channel
+ris::MasterPtr ris::Demux::output(uint8_t channel) {
+    std::shared_ptr<Output> out;
+    char name[50];
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (table_[channel] != NULL) return table_[channel].load()->master;
+
+    snprintf(name, sizeof(name), "ch%" PRIu8 ".errorDropCount", channel);
+
+    out             = std::make_shared<Output>();
+    out->master     = ris::Master::create();
+    out->dropErrors = false;
+    out->dropCnt    = metrics_->counter(name);
+
+    outputs_.push_back(out);
+    table_[channel] = out.get();
+
+    return out->master;
+}
+
+//! Set the error drop flag of a channel output
+void ris::Demux::setDropErrors(uint8_t channel, bool drop) {
+    output(channel);
+    table_[channel].load()->dropErrors = drop;
+}
+
+//! Get the number of errored frames dropped by a channel output
+uint64_t ris::Demux::dropCnt(uint8_t channel) {
+    Output* out = table_[channel];
+
+    return (out == NULL) ? 0 : out->dropCnt->get();
+}
+
+//! Get the number of frames dropped because their channel has no output
+uint64_t ris::Demux::unmatchedCnt() {
+    return unmatchedCnt_->get();
+}
+
+//! Return the output for a frame
+ris::Demux::Output* ris::Demux::route(ris::FramePtr& frame) {
+    Output* out = table_[frame->getChannel()];
+
+    if (out == NULL) {
+        unmatchedCnt_->inc();
+        return NULL;
+    }
+
+    // Drop errored frames
+    if (out->dropErrors && (frame->getError() != 0)) {
+        log_->debug("Dropping errored frame: Channel=%" PRIu8 ", Error=0x%" PRIx8,
+                    frame->getChannel(),
+                    frame->getError());
+        out->dropCnt->inc();
+        return NULL;
+    }
+    return out;
+}
+
+//! Accept a frame from master
+void ris::Demux::acceptFrame(ris::FramePtr frame) {
+    Output* out;
+
+    if ((out = route(frame)) != NULL) out->master->sendFrame(frame);
+}
+
+//! Accept a batch of frames from master
+void ris::Demux::acceptFrames(std::vector<ris::FramePtr>& frames) {
+    std::vector<ris::FramePtr>::iterator it;
+    std::vector<ris::FramePtr> run;
+    Output* last;
+    Output* out;
+
+    run.reserve(frames.size());
+    last = NULL;
+
+    // Forward runs of consecutive frames for the same output as one batch
+    for (it = frames.begin(); it != frames.end(); ++it) {
+        if ((out = route(*it)) == NULL) continue;
+
+        if (out != last && !run.empty()) {
+            last->master->sendFrames(run);
+            run.clear();
+        }
+        run.push_back(*it);
+        last = out;
+    }
+
+    if (!run.empty()) last->master->sendFrames(run);
+}
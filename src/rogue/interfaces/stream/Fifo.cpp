@@ -18,13 +18,21 @@
 
 #include "rogue/interfaces/stream/Fifo.h"
 
+#include <inttypes.h>
 #include <stdint.h>
 
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
+#include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Histogram.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
@@ -53,7 +61,11 @@ void ris::Fifo::setup_python() {
         bp::init<uint32_t, uint32_t, bool>())
         .def("size", &Fifo::size)
         .def("dropCnt", &Fifo::dropCnt)
-        .def("clearCnt", &Fifo::clearCnt);
+        .def("clearCnt", &Fifo::clearCnt)
+        .def("setBackpressure", &Fifo::setBackpressure)
+        .def("blockCnt", &Fifo::blockCnt)
+        .def("blockTime", &Fifo::blockTime)
+        .def("threads", &Fifo::threads);
 #endif
 }
 
@@ -65,15 +77,21 @@ ris::Fifo::Fifo(uint32_t maxDepth, uint32_t trimSize, bool noCopy)
       maxDepth_(maxDepth),
       trimSize_(trimSize),
       noCopy_(noCopy),
-      dropFrameCnt_(0),
+      highWater_(0),
+      lowWater_(0),
+      bpTimeout_(0),
+      bpWait_(0),
+      blocked_(false),
       threadEn_(true),
-      thread_(new std::thread(&ris::Fifo::runThread, this)) {
+      threadSet_(rogue::ThreadSet::create("stream.Fifo")) {
     queue_.setThold(maxDepth);
 
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "Fifo");
-#endif
+    metrics_->setPrefix("stream.Fifo");
+    dropFrameCnt_ = metrics_->counter("dropCount");
+    blockCnt_     = metrics_->counter("blockCount");
+    blockTime_    = metrics_->counter("blockTime");
+
+    thread_ = threadSet_->start("Fifo", std::bind(&ris::Fifo::runThread, this));
 }
 
 //! Deconstructor
@@ -92,12 +110,96 @@ std::size_t ris::Fifo::size() {
 
 //! Return the number of dropped frames
 std::size_t ris::Fifo::dropCnt() const {
-    return dropFrameCnt_;
+    return dropFrameCnt_->get();
 }
 
 //! Clear counters
 void ris::Fifo::clearCnt() {
-    dropFrameCnt_ = 0;
+    dropFrameCnt_->set(0);
+    blockCnt_->set(0);
+    blockTime_->set(0);
+}
+
+//! Enable backpressure mode
+void ris::Fifo::setBackpressure(uint32_t highWater, uint32_t lowWater, uint32_t timeout) {
+    if (highWater != 0 && lowWater >= highWater)
+        throw(rogue::GeneralError::create("Fifo::setBackpressure",
+                                          "Low watermark %" PRIu32 " must be less than high watermark %" PRIu32,
+                                          lowWater,
+                                          highWater));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(bpMtx_);
+
+    lowWater_  = lowWater;
+    bpTimeout_ = timeout;
+    highWater_ = highWater;
+
+    // Release any waiters so they re-evaluate against the new settings
+    blocked_ = false;
+    bpCond_.notify_all();
+}
+
+//! Get number of backpressure waits
+uint64_t ris::Fifo::blockCnt() const {
+    return blockCnt_->get();
+}
+
+//! Get total blocked time
+uint64_t ris::Fifo::blockTime() const {
+    return blockTime_->get();
+}
+
+//! Get the thread set
+rogue::ThreadSetPtr ris::Fifo::threads() {
+    return threadSet_;
+}
+
+//! Wait for the FIFO to drain to the low watermark
+/*
+ * Once a producer finds the FIFO at the high watermark every producer waits
+ * until the thread has drained it to the low watermark. The thread only
+ * notifies when a producer is waiting, so the fast path takes no lock.
+ */
+bool ris::Fifo::waitDrain(uint32_t highWater) {
+    uint64_t start;
+    uint64_t now;
+    uint64_t end;
+    bool ret;
+
+    if (!blocked_.load(std::memory_order_relaxed) && queue_.size() < highWater) return true;
+
+    std::unique_lock<std::mutex> lock(bpMtx_);
+
+    // Settings changed while acquiring the lock
+    if (highWater_ == 0) return true;
+
+    start    = rogue::monotonicNs();
+    end      = start + static_cast<uint64_t>(bpTimeout_) * 1000;
+    ret      = true;
+    blocked_ = true;
+
+    bpWait_++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    while (blocked_ && queue_.size() > lowWater_) {
+        if (bpTimeout_ == 0) {
+            bpCond_.wait(lock);
+        } else if ((now = rogue::monotonicNs()) < end) {
+            bpCond_.wait_for(lock, std::chrono::nanoseconds(end - now));
+        } else {
+            ret = false;
+            break;
+        }
+    }
+    bpWait_--;
+
+    // Drained, release the other producers
+    if (ret) blocked_ = false;
+
+    blockCnt_->inc();
+    blockTime_->inc(rogue::monotonicNs() - start);
+    return ret;
 }
 
 //! Accept a frame from master
@@ -106,14 +208,24 @@ void ris::Fifo::acceptFrame(ris::FramePtr frame) {
     ris::FramePtr nFrame;
     ris::FrameIterator src;
     ris::FrameIterator dst;
+    uint32_t highWater;
+
+    highWater = highWater_.load(std::memory_order_relaxed);
 
     // FIFO is full, drop frame
-    if (queue_.busy()) {
-        ++dropFrameCnt_;
+    if (highWater == 0 && queue_.busy()) {
+        dropFrameCnt_->inc();
         return;
     }
 
     rogue::GilRelease noGil;
+
+    // Backpressure mode, wait for the FIFO to drain and drop on timeout
+    if (highWater != 0 && !waitDrain(highWater)) {
+        dropFrameCnt_->inc();
+        return;
+    }
+
     ris::FrameLockPtr lock = frame->lock();
 
     // Do we copy the frame?
@@ -137,18 +249,39 @@ void ris::Fifo::acceptFrame(ris::FramePtr frame) {
         nFrame->setError(frame->getError());
         nFrame->setChannel(frame->getChannel());
         nFrame->setFlags(frame->getFlags());
+        nFrame->setTimestamp(frame->getTimestamp());
     }
 
     // Append to buffer
     queue_.push(nFrame);
 }
 
+//! Accept a batch of frames from master
+void ris::Fifo::acceptFrames(std::vector<ris::FramePtr>& frames) {
+    std::vector<ris::FramePtr>::iterator it;
+
+    rogue::GilRelease noGil;
+    for (it = frames.begin(); it != frames.end(); ++it) acceptFrame(*it);
+}
+
 //! Thread background
 void ris::Fifo::runThread() {
-    ris::FramePtr frame;
+    std::vector<ris::FramePtr> frames;
     log_->logThreadId();
 
+    frames.reserve(PopBatch);
+
     while (threadEn_) {
-        if ((frame = queue_.pop()) != NULL) sendFrame(frame);
+        if (queue_.popN(frames, PopBatch) > 0) {
+            // Wake blocked producers before forwarding so they refill while we send
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (bpWait_.load(std::memory_order_relaxed) > 0 && queue_.size() <= lowWater_) {
+                std::lock_guard<std::mutex> lock(bpMtx_);
+                bpCond_.notify_all();
+            }
+
+            sendFrames(frames);
+            frames.clear();
+        }
     }
 }
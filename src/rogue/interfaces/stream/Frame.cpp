@@ -24,6 +24,8 @@
 #include <memory>
 
 #include "rogue/GeneralError.h"
+#include "rogue/Histogram.h"
+#include "rogue/ObjectPool.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
 #include "rogue/interfaces/stream/FrameLock.h"
@@ -38,9 +40,36 @@ namespace bp = boost::python;
 #endif
 
 //! Create an empty frame
+/*
+ * Frames are recycled through a free list, which also keeps the buffer
+ * list capacity of the previous user.
+ */
 ris::FramePtr ris::Frame::create() {
-    ris::FramePtr frame = std::make_shared<ris::Frame>();
-    return (frame);
+    ris::Frame* frame;
+
+    if ((frame = static_cast<ris::Frame*>(rogue::FreeList<ris::Frame>::get())) == NULL) {
+        rogue::objectPoolHeapCount()++;
+        frame = new ris::Frame();
+    }
+    return (ris::FramePtr(frame, ris::Frame::Recycle(), rogue::PoolAllocator<ris::Frame>()));
+}
+
+//! Return a released frame to the free list
+void ris::Frame::Recycle::operator()(ris::Frame* frame) const {
+    frame->buffers_.clear();
+    frame->flags_     = 0;
+    frame->error_     = 0;
+    frame->size_      = 0;
+    frame->chan_      = 0;
+    frame->timestamp_ = 0;
+    frame->payload_   = 0;
+    frame->sizeDirty_ = false;
+    rogue::FreeList<ris::Frame>::put(frame);
+}
+
+//! Get heap allocation count
+uint64_t ris::Frame::getHeapAllocCount() {
+    return rogue::objectPoolHeapCount();
 }
 
 //! Create an empty frame
@@ -49,6 +78,7 @@ ris::Frame::Frame() {
     error_     = 0;
     size_      = 0;
     chan_      = 0;
+    timestamp_ = 0;
     payload_   = 0;
     sizeDirty_ = false;
 }
@@ -84,6 +114,44 @@ ris::Frame::BufferIterator ris::Frame::appendFrame(ris::FramePtr frame) {
     return (buffers_.begin() + oSize);
 }
 
+//! Create a view of a byte range of this frame
+ris::FramePtr ris::Frame::slice(uint32_t offset, uint32_t size) {
+    ris::Frame::BufferIterator it;
+    ris::FramePtr ret;
+    uint32_t bSize;
+    uint32_t cSize;
+
+    if ((static_cast<uint64_t>(offset) + size) > getPayload())
+        throw(rogue::GeneralError::create("Frame::slice",
+                                          "Slice at offset %" PRIu32 " with size %" PRIu32
+                                          " exceeds frame payload %" PRIu32,
+                                          offset,
+                                          size,
+                                          getPayload()));
+
+    ret = ris::Frame::create();
+
+    for (it = buffers_.begin(); size > 0 && it != buffers_.end(); ++it) {
+        bSize = (*it)->getPayload();
+
+        // Slice starts past this buffer
+        if (offset >= bSize) {
+            offset -= bSize;
+            continue;
+        }
+
+        cSize = ((bSize - offset) > size) ? size : (bSize - offset);
+        ret->appendBuffer(ris::Buffer::createView(*it, offset, cSize));
+        offset = 0;
+        size -= cSize;
+    }
+
+    ret->setError(error_);
+    ret->setChannel(chan_);
+    ret->setTimestamp(timestamp_);
+    return (ret);
+}
+
 //! Buffer begin iterator
 ris::Frame::BufferIterator ris::Frame::beginBuffer() {
     return (buffers_.begin());
@@ -313,6 +381,21 @@ void ris::Frame::setChannel(uint8_t channel) {
     chan_ = channel;
 }
 
+//! Get ingress timestamp
+uint64_t ris::Frame::getTimestamp() {
+    return timestamp_;
+}
+
+//! Set ingress timestamp
+void ris::Frame::setTimestamp(uint64_t timestamp) {
+    timestamp_ = timestamp;
+}
+
+//! Set ingress timestamp to the current time
+void ris::Frame::stamp() {
+    timestamp_ = rogue::monotonicNs();
+}
+
 //! Get start iterator
 ris::FrameIterator ris::Frame::begin() {
     return ris::FrameIterator(shared_from_this(), false, false);
@@ -478,6 +561,58 @@ boost::python::object ris::Frame::getNumpy(uint32_t offset, uint32_t count, bp::
     return p;
 }
 
+//! Return numpy arrays referencing the data in each buffer
+boost::python::object ris::Frame::getNumpyView(bp::object dtype) {
+    ris::Frame::BufferIterator it;
+
+    PyObject* dtype_pyobj = dtype.ptr();
+    if (!PyArray_DescrCheck(dtype_pyobj)) {
+        throw(rogue::GeneralError::create("Frame::getNumpyView",
+                                          "Invalid dtype argument. Must be a NumPy dtype object."));
+    }
+    PyArray_Descr* descr = reinterpret_cast<PyArray_Descr*>(dtype_pyobj);
+    uint32_t item        = bp::extract<uint32_t>(dtype.attr("itemsize"));
+
+    // Python frame object used as the base of each array, keeping this frame alive
+    bp::object frame(shared_from_this());
+    bp::list arrays;
+
+    for (it = buffers_.begin(); it != buffers_.end(); ++it) {
+        uint32_t size = (*it)->getPayload();
+
+        if (item == 0 || (size % item) != 0) {
+            throw(rogue::GeneralError::create("Frame::getNumpyView",
+                                              "Buffer payload size %" PRIu32
+                                              " is not a multiple of the item size %" PRIu32,
+                                              size,
+                                              item));
+        }
+
+        // The array steals the descriptor and base references
+        npy_intp dims[1] = {size / item};
+        Py_INCREF(descr);
+        PyObject* obj = PyArray_NewFromDescr(&PyArray_Type,
+                                             descr,
+                                             1,
+                                             dims,
+                                             NULL,
+                                             (*it)->begin(),
+                                             NPY_ARRAY_CARRAY,
+                                             NULL);
+        if (obj == NULL) bp::throw_error_already_set();
+        bp::object arr((bp::handle<>(obj)));
+
+        Py_INCREF(frame.ptr());
+        if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj), frame.ptr()) != 0)
+            bp::throw_error_already_set();
+
+        arrays.append(arr);
+    }
+
+    if (bp::len(arrays) == 1) return arrays[0];
+    return bp::tuple(arrays);
+}
+
 //! Write the all the data associated with the input numpy array
 void ris::Frame::putNumpy(boost::python::object p, uint32_t offset) {
     // Retrieve pointer to PyObject
@@ -548,6 +683,7 @@ void ris::Frame::setup_python() {
         .def("getSize", &ris::Frame::getSize)
         .def("getAvailable", &ris::Frame::getAvailable)
         .def("getPayload", &ris::Frame::getPayload)
+        .def("slice", &ris::Frame::slice)
         .def("read", &ris::Frame::readPy, (bp::arg("offset") = 0))
         .def("getBa", &ris::Frame::getBytearrayPy, (bp::arg("offset") = 0, bp::arg("count") = 0))
         .def("getMemoryview", &ris::Frame::getMemoryviewPy)
@@ -562,13 +698,21 @@ void ris::Frame::setup_python() {
         .def("getLastUser", &ris::Frame::getLastUser)
         .def("setChannel", &ris::Frame::setChannel)
         .def("getChannel", &ris::Frame::getChannel)
+        .def("setTimestamp", &ris::Frame::setTimestamp)
+        .def("getTimestamp", &ris::Frame::getTimestamp)
+        .def("stamp", &ris::Frame::stamp)
         .def("getNumpy",
              &ris::Frame::getNumpy,
              (bp::arg("offset") = 0,
               bp::arg("count")  = 0,
               bp::arg("dtype")  = bp::object(bp::handle<>(bp::borrowed(dtype_uint8)))))
+        .def("getNumpyView",
+             &ris::Frame::getNumpyView,
+             (bp::arg("dtype") = bp::object(bp::handle<>(bp::borrowed(dtype_uint8)))))
         .def("putNumpy", &ris::Frame::putNumpy, (bp::arg("offset") = 0))
-        .def("_debug", &ris::Frame::debug);
+        .def("_debug", &ris::Frame::debug)
+        .def("getHeapAllocCount", &ris::Frame::getHeapAllocCount)
+        .staticmethod("getHeapAllocCount");
 #endif
 }
 
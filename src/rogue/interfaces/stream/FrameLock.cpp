@@ -21,6 +21,7 @@
 #include <memory>
 
 #include "rogue/GilRelease.h"
+#include "rogue/ObjectPool.h"
 #include "rogue/interfaces/stream/Frame.h"
 
 namespace ris = rogue::interfaces::stream;
@@ -32,7 +33,7 @@ namespace bp = boost::python;
 
 //! Create a frame container
 ris::FrameLockPtr ris::FrameLock::create(ris::FramePtr frame) {
-    ris::FrameLockPtr frameLock = std::make_shared<ris::FrameLock>(frame);
+    ris::FrameLockPtr frameLock = std::allocate_shared<ris::FrameLock>(rogue::PoolAllocator<ris::FrameLock>(), frame);
     return (frameLock);
 }
 
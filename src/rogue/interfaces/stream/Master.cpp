@@ -18,6 +18,7 @@
 
 #include "rogue/interfaces/stream/Master.h"
 
+#include <inttypes.h>
 #include <unistd.h>
 
 #include <memory>
@@ -25,8 +26,10 @@
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Histogram.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
+#include "rogue/interfaces/stream/Pool.h"
 #include "rogue/interfaces/stream/Slave.h"
 
 namespace ris = rogue::interfaces::stream;
@@ -44,7 +47,12 @@ ris::MasterPtr ris::Master::create() {
 
 //! Creator
 ris::Master::Master() {
-    defSlave_ = ris::Slave::create();
+    std::shared_ptr<const SlaveList> empty = std::make_shared<SlaveList>();
+
+    slaveHist_.push_back(empty);
+    slaves_   = empty.get();
+    latency_  = NULL;
+    defSlave_ = std::make_shared<ris::Pool>();
 }
 
 //! Destructor
@@ -52,39 +60,132 @@ ris::Master::~Master() {}
 
 // Get Slave Count
 uint32_t ris::Master::slaveCount() {
-    return slaves_.size();
+    return slaves_.load(std::memory_order_acquire)->size();
 }
 
 //! Add slave
+/*
+ * Publish a new snapshot with the slave appended. Old snapshots may still be
+ * in use by a sending thread and are kept in the history list.
+ */
 void ris::Master::addSlave(ris::SlavePtr slave) {
     rogue::GilRelease noGil;
     std::lock_guard<std::mutex> lock(slaveMtx_);
-    slaves_.push_back(slave);
+
+    std::shared_ptr<SlaveList> list = std::make_shared<SlaveList>(*slaves_.load(std::memory_order_relaxed));
+    list->push_back(slave);
+
+    slaveHist_.push_back(list);
+    slaves_.store(list.get(), std::memory_order_release);
+
+    if (latency_.load(std::memory_order_relaxed) != NULL) publishLatency();
+}
+
+//! Publish latency snapshot
+/*
+ * Histograms are created for any slaves added since the last update. The
+ * snapshot may briefly be shorter than the slave list, sendFrame() checks
+ * the size before recording. Histograms are only ever appended, so the last
+ * snapshot is reused when no slaves were added and toggling tracing does not
+ * grow the history list.
+ */
+void ris::Master::publishLatency() {
+    while (latencyAll_.size() < slaves_.load(std::memory_order_relaxed)->size())
+        latencyAll_.push_back(rogue::Histogram::create());
+
+    if (latencyHist_.empty() || latencyHist_.back()->size() != latencyAll_.size())
+        latencyHist_.push_back(std::make_shared<LatencyList>(latencyAll_));
+
+    latency_.store(latencyHist_.back().get(), std::memory_order_release);
+}
+
+//! Enable or disable latency tracing
+void ris::Master::setTracing(bool enable) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(slaveMtx_);
+
+    if (enable)
+        publishLatency();
+    else
+        latency_.store(NULL, std::memory_order_release);
+}
+
+//! Get latency tracing state
+bool ris::Master::getTracing() {
+    return (latency_.load(std::memory_order_acquire) != NULL);
+}
+
+//! Get latency histogram for a slave
+rogue::HistogramPtr ris::Master::getLatency(uint32_t index) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(slaveMtx_);
+
+    if (index >= latencyAll_.size())
+        throw(rogue::GeneralError::create("stream::Master::getLatency",
+                                          "No latency histogram for slave %" PRIu32 ", tracing enabled = %i",
+                                          index,
+                                          (latency_.load(std::memory_order_relaxed) != NULL)));
+
+    return latencyAll_[index];
 }
 
 //! Request frame from primary slave
 ris::FramePtr ris::Master::reqFrame(uint32_t size, bool zeroCopyEn) {
     rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(slaveMtx_);
+    const SlaveList* slaves = slaves_.load(std::memory_order_acquire);
 
-    if (slaves_.size() == 0)
+    if (slaves->size() == 0)
         return (defSlave_->acceptReq(size, zeroCopyEn));
     else
-        return (slaves_[0]->acceptReq(size, zeroCopyEn));
+        return ((*slaves)[0]->acceptReq(size, zeroCopyEn));
 }
 
 //! Push frame to slaves
 void ris::Master::sendFrame(FramePtr frame) {
-    std::vector<ris::SlavePtr> slaves;
-    std::vector<ris::SlavePtr>::reverse_iterator rit;
+    const SlaveList* slaves     = slaves_.load(std::memory_order_acquire);
+    const LatencyList* latency = latency_.load(std::memory_order_acquire);
+    SlaveList::const_reverse_iterator rit;
+    uint64_t stamp;
+    uint32_t x;
+
+    if (latency == NULL || (stamp = frame->getTimestamp()) == 0) {
+        for (rit = slaves->rbegin(); rit != slaves->rend(); ++rit) (*rit)->acceptFrame(frame);
+        return;
+    }
+
+    // Tracing, record the frame age as it is passed to each slave
+    for (x = slaves->size(); x > 0; --x) {
+        if (x <= latency->size()) (*latency)[x - 1]->record(rogue::monotonicNs() - stamp);
+        (*slaves)[x - 1]->acceptFrame(frame);
+    }
+}
 
-    {
-        rogue::GilRelease noGil;
-        std::lock_guard<std::mutex> lock(slaveMtx_);
-        slaves = slaves_;
+//! Push a batch of frames to slaves
+void ris::Master::sendFrames(std::vector<ris::FramePtr>& frames) {
+    const SlaveList* slaves     = slaves_.load(std::memory_order_acquire);
+    const LatencyList* latency = latency_.load(std::memory_order_acquire);
+    std::vector<ris::FramePtr>::iterator it;
+    SlaveList::const_reverse_iterator rit;
+    uint64_t now;
+    uint64_t stamp;
+    uint32_t x;
+
+    if (frames.empty()) return;
+
+    if (latency == NULL) {
+        for (rit = slaves->rbegin(); rit != slaves->rend(); ++rit) (*rit)->acceptFrames(frames);
+        return;
     }
 
-    for (rit = slaves.rbegin(); rit != slaves.rend(); ++rit) (*rit)->acceptFrame(frame);
+    // Tracing, record the age of each frame in the batch as it is passed to each slave
+    for (x = slaves->size(); x > 0; --x) {
+        if (x <= latency->size()) {
+            now = rogue::monotonicNs();
+            for (it = frames.begin(); it != frames.end(); ++it)
+                if ((stamp = (*it)->getTimestamp()) != 0) (*latency)[x - 1]->record(now - stamp);
+        }
+        (*slaves)[x - 1]->acceptFrames(frames);
+    }
 }
 
 // Ensure passed frame is a single buffer
@@ -127,6 +228,9 @@ void ris::Master::setup_python() {
         .def("_reqFrame", &ris::Master::reqFrame)
         .def("_sendFrame", &ris::Master::sendFrame)
         .def("_stop", &ris::Master::stop)
+        .def("setTracing", &ris::Master::setTracing)
+        .def("getTracing", &ris::Master::getTracing)
+        .def("getLatency", &ris::Master::getLatency)
         .def("__eq__", &ris::Master::equalsPy)
         .def("__rshift__", &ris::Master::rshiftPy);
 
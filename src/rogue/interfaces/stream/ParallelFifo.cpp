@@ -0,0 +1,265 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Stream Frame FIFO with parallel workers and ordered output
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/stream/ParallelFifo.h"
+
+#include <inttypes.h>
+
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/Threads.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace ris = rogue::interfaces::stream;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Input frame currently being processed by this worker thread
+struct WorkerContext {
+    ris::ParallelFifoOutput* port;
+    uint64_t seq;
+};
+
+static thread_local WorkerContext workerContext_ = {NULL, 0};
+
+//! Setup output port in python
+void ris::ParallelFifoOutput::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<ris::ParallelFifoOutput,
+               ris::ParallelFifoOutputPtr,
+               bp::bases<ris::Master, ris::Slave>,
+               boost::noncopyable>("ParallelFifoOutput", bp::no_init)
+        .def("pending", &ris::ParallelFifoOutput::pending);
+
+    bp::implicitly_convertible<ris::ParallelFifoOutputPtr, ris::MasterPtr>();
+    bp::implicitly_convertible<ris::ParallelFifoOutputPtr, ris::SlavePtr>();
+#endif
+}
+
+//! Create output port
+ris::ParallelFifoOutput::ParallelFifoOutput(bool ordered) : ris::Master(), ris::Slave(), ordered_(ordered), nextSeq_(0) {}
+
+//! Destroy output port
+ris::ParallelFifoOutput::~ParallelFifoOutput() {}
+
+//! Accept a frame from the worker stage
+void ris::ParallelFifoOutput::acceptFrame(ris::FramePtr frame) {
+    WorkerContext& ctx = workerContext_;
+
+    // Not from one of our workers, nothing to order against
+    if (!ordered_ || ctx.port != this) {
+        sendFrame(frame);
+        return;
+    }
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    // Head of the order forwards directly, otherwise hold until it reaches the head
+    if (ctx.seq == nextSeq_)
+        sendFrame(frame);
+    else
+        pending_[ctx.seq].frames.push_back(frame);
+}
+
+//! Mark processing of an input frame complete
+/*
+ * When the head completes, forward the held output of each following input
+ * frame until reaching one which is still being processed. That input becomes
+ * the new head and forwards its remaining output directly.
+ */
+void ris::ParallelFifoOutput::done(uint64_t seq) {
+    std::map<uint64_t, Slot>::iterator it;
+    std::vector<ris::FramePtr>::iterator fit;
+
+    if (!ordered_) return;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (seq != nextSeq_) {
+        pending_[seq].done = true;
+        return;
+    }
+
+    nextSeq_++;
+
+    while ((it = pending_.find(nextSeq_)) != pending_.end()) {
+        for (fit = it->second.frames.begin(); fit != it->second.frames.end(); ++fit) sendFrame(*fit);
+
+        if (!it->second.done) {
+            pending_.erase(it);
+            break;
+        }
+
+        pending_.erase(it);
+        nextSeq_++;
+    }
+}
+
+//! Get reorder buffer depth
+uint32_t ris::ParallelFifoOutput::pending() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return pending_.size();
+}
+
+//! Class creation
+ris::ParallelFifoPtr ris::ParallelFifo::create(uint32_t maxDepth, uint32_t threads, bool ordered) {
+    ris::ParallelFifoPtr p = std::make_shared<ris::ParallelFifo>(maxDepth, threads, ordered);
+    return (p);
+}
+
+//! Setup class in python
+void ris::ParallelFifo::setup_python() {
+#ifndef NO_PYTHON
+    ris::ParallelFifoOutput::setup_python();
+
+    bp::class_<ris::ParallelFifo, ris::ParallelFifoPtr, bp::bases<ris::Master, ris::Slave>, boost::noncopyable>(
+        "ParallelFifo",
+        bp::init<uint32_t, uint32_t, bool>())
+        .def("output", &ParallelFifo::output)
+        .def("size", &ParallelFifo::size)
+        .def("dropCnt", &ParallelFifo::dropCnt)
+        .def("clearCnt", &ParallelFifo::clearCnt)
+        .def("threads", &ParallelFifo::threads);
+
+    bp::implicitly_convertible<ris::ParallelFifoPtr, ris::MasterPtr>();
+    bp::implicitly_convertible<ris::ParallelFifoPtr, ris::SlavePtr>();
+#endif
+}
+
+//! Creator
+ris::ParallelFifo::ParallelFifo(uint32_t maxDepth, uint32_t threads, bool ordered)
+    : ris::Master(),
+      ris::Slave(),
+      log_(rogue::Logging::create("stream.ParallelFifo")),
+      maxDepth_(maxDepth),
+      seq_(0),
+      output_(std::make_shared<ris::ParallelFifoOutput>(ordered)),
+      threadEn_(true),
+      threadSet_(rogue::ThreadSet::create("stream.ParallelFifo")) {
+    uint32_t x;
+
+    if (threads == 0)
+        throw(rogue::GeneralError::create("ParallelFifo::ParallelFifo", "At least one worker thread is required"));
+
+    queue_.setThold(maxDepth);
+
+    metrics_->setPrefix("stream.ParallelFifo");
+    dropFrameCnt_ = metrics_->counter("dropCount");
+
+    for (x = 0; x < threads; x++)
+        threads_.push_back(threadSet_->start("ParallelFifo", std::bind(&ris::ParallelFifo::runThread, this)));
+}
+
+//! Deconstructor
+ris::ParallelFifo::~ParallelFifo() {
+    std::vector<std::thread*>::iterator it;
+
+    threadEn_ = false;
+    rogue::GilRelease noGil;
+    queue_.stop();
+
+    for (it = threads_.begin(); it != threads_.end(); ++it) {
+        (*it)->join();
+        delete *it;
+    }
+}
+
+//! Get output port
+ris::ParallelFifoOutputPtr ris::ParallelFifo::output() {
+    return output_;
+}
+
+//! Return the number of elements in the queue
+std::size_t ris::ParallelFifo::size() {
+    return queue_.size();
+}
+
+//! Return the number of dropped frames
+std::size_t ris::ParallelFifo::dropCnt() const {
+    return dropFrameCnt_->get();
+}
+
+//! Clear counters
+void ris::ParallelFifo::clearCnt() {
+    dropFrameCnt_->set(0);
+}
+
+//! Get the thread set
+rogue::ThreadSetPtr ris::ParallelFifo::threads() {
+    return threadSet_;
+}
+
+//! Accept a frame from master
+void ris::ParallelFifo::acceptFrame(ris::FramePtr frame) {
+    Work work;
+
+    // Queue is full, drop frame
+    if (queue_.busy()) {
+        dropFrameCnt_->inc();
+        return;
+    }
+
+    rogue::GilRelease noGil;
+
+    work.seq   = seq_++;
+    work.frame = frame;
+    queue_.push(work);
+}
+
+//! Worker thread
+void ris::ParallelFifo::runThread() {
+    WorkerContext& ctx = workerContext_;
+    Work work;
+
+    log_->logThreadId();
+
+    while (threadEn_) {
+        work = queue_.pop();
+        if (!work.frame) continue;
+
+        ctx.port = output_.get();
+        ctx.seq  = work.seq;
+
+        // A failed frame must still release its place in the order
+        try {
+            sendFrame(work.frame);
+        } catch (std::exception& e) {
+            log_->error("Worker failed to process frame %" PRIu64 ": %s", work.seq, e.what());
+        }
+
+        work.frame.reset();
+        ctx.port = NULL;
+        output_->done(work.seq);
+    }
+}
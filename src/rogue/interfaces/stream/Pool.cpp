@@ -21,13 +21,19 @@
 #include "rogue/interfaces/stream/Pool.h"
 
 #include <inttypes.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/Metrics.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 
@@ -38,30 +44,123 @@ namespace ris = rogue::interfaces::stream;
 namespace bp = boost::python;
 #endif
 
+//! Buffer arena
+/*
+ * A single mapped region which is divided into fixed size buffers. The region
+ * is unmapped when the last reference, held by the pool and by any thread
+ * caches holding arena buffers, goes away.
+ */
+struct ris::Pool::Arena {
+    uint8_t* base;
+    uint64_t size;
+    uint32_t count;
+
+    Arena() : base(NULL), size(0), count(0) {}
+
+    ~Arena() {
+        if (base != NULL) munmap(base, size);
+    }
+
+    bool contains(uint8_t* data) const {
+        return (data >= base && data < (base + size));
+    }
+};
+
+//! Per thread buffer cache
+/*
+ * Holds one magazine per pool used by the thread. Entries are keyed by the
+ * pool id and hold a weak pointer so that buffers can be handed back to a
+ * live pool, or freed if the pool is gone, when the thread exits.
+ */
+struct ris::Pool::ThreadCache {
+    struct Entry {
+        uint64_t id;
+        std::weak_ptr<ris::Pool> pool;
+        std::shared_ptr<ris::Pool::Arena> arena;
+        std::vector<uint8_t*> data;
+    };
+
+    // Free buffers held for a pool which no longer exists, arena buffers are left to the arena
+    static void release(Entry& entry) {
+        std::vector<uint8_t*>::iterator it;
+
+        for (it = entry.data.begin(); it != entry.data.end(); ++it) {
+            if (!(entry.arena && entry.arena->contains(*it))) free(*it);
+        }
+        entry.data.clear();
+    }
+
+    std::vector<Entry> entries;
+    uint32_t last;
+    bool alive;
+
+    ThreadCache() : last(0), alive(true) {}
+
+    ~ThreadCache() {
+        std::vector<Entry> local;
+        std::vector<Entry>::iterator it;
+
+        // Buffers released while draining must bypass the cache
+        alive = false;
+        local.swap(entries);
+
+        for (it = local.begin(); it != local.end(); ++it) {
+            ris::PoolPtr pool = it->pool.lock();
+
+            if (pool) {
+                pool->cacheDrain(&(it->data), 0);
+            } else {
+                release(*it);
+            }
+        }
+    }
+};
+
+thread_local ris::Pool::ThreadCache ris::Pool::threadCache_;
+
+static std::atomic<uint64_t> poolIdNext_(0);
+
+// Huge page size used to round arena mappings
+static const uint64_t HugePageSize = 0x200000;
+
+// NUMA memory policy which restricts allocations to the passed nodes
+static const int MpolBind = 2;
+
 //! Creator
 ris::Pool::Pool() {
+    poolId_     = poolIdNext_++;
+    arena_      = NULL;
     allocMeta_  = 0;
-    allocBytes_ = 0;
-    allocCount_ = 0;
+    allocBytes_ = rogue::Gauge::create();
+    allocCount_ = rogue::Gauge::create();
+    freeCount_  = 0;
     fixedSize_  = 0;
     poolSize_   = 0;
+    cacheDepth_ = 32;
+    cacheMiss_  = rogue::Counter::create();
+
+    poolMetricsPend_ = false;
 }
 
 //! Destructor
 ris::Pool::~Pool() {
+    Arena* arena = arena_;
+
+    // Arena buffers are released when the arena is unmapped
     while (!dataQ_.empty()) {
-        free(dataQ_.front());
+        if (arena == NULL || !arena->contains(dataQ_.front())) free(dataQ_.front());
+        dataQ_.pop();
     }
 }
 
 //! Get allocated memory
 uint32_t ris::Pool::getAllocBytes() {
-    return (allocBytes_);
+    return (allocBytes_->get());
 }
 
 //! Get allocated count
 uint32_t ris::Pool::getAllocCount() {
-    return (allocCount_);
+    return (allocCount_->get());
 }
 
 //! Accept a frame request. Called from master
@@ -86,17 +185,113 @@ ris::FramePtr ris::Pool::acceptReq(uint32_t size, bool zeroCopyEn) {
  * Called when this instance is marked as owner of a Buffer entity
  */
 void ris::Pool::retBuffer(uint8_t* data, uint32_t meta, uint32_t rawSize) {
-    rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<uint8_t*>* cache;
+    Arena* arena = arena_;
+    bool keep    = false;
 
     if (data != NULL) {
-        if (rawSize == fixedSize_ && poolSize_ > dataQ_.size())
-            dataQ_.push(data);
-        else
+        // Arena buffers are always kept
+        if (arena != NULL && arena->contains(data)) {
+            freeCount_++;
+            keep = true;
+
+            // Reserve a free list slot, the pool size bounds the queue plus all thread caches
+        } else if (rawSize == fixedSize_) {
+            if (freeCount_++ < poolSize_)
+                keep = true;
+            else
+                freeCount_--;
+        }
+
+        if (!keep) {
             free(data);
+
+            // Return to the local cache, drain half of it to the pool when full
+        } else if ((cache = localCache()) != NULL) {
+            if (cache->size() >= cacheDepth_) cacheDrain(cache, cacheDepth_ / 2);
+            cache->push_back(data);
+
+        } else {
+            rogue::GilRelease noGil;
+            std::lock_guard<std::mutex> lock(mtx_);
+            dataQ_.push(data);
+        }
+    }
+    allocBytes_->add(-static_cast<int64_t>(rawSize));
+    allocCount_->add(-1);
+}
+
+//! Get the calling thread's cache for this pool
+std::vector<uint8_t*>* ris::Pool::localCache() {
+    ris::Pool::ThreadCache& tc = threadCache_;
+    uint32_t x;
+
+    if (cacheDepth_ == 0 || (poolSize_ == 0 && arena_ == NULL) || !tc.alive) return NULL;
+
+    // Most threads only touch one pool, check the last used entry first
+    if (tc.last < tc.entries.size() && tc.entries[tc.last].id == poolId_) return &(tc.entries[tc.last].data);
+
+    for (x = 0; x < tc.entries.size(); x++) {
+        if (tc.entries[x].id == poolId_) {
+            tc.last = x;
+            return &(tc.entries[x].data);
+        }
+    }
+
+    ris::Pool::ThreadCache::Entry entry;
+    entry.id   = poolId_;
+    entry.pool = shared_from_this();
+
+    // Purge entries for pools which no longer exist, entries left under an older id
+    // of this pool by setArena() are drained back to the buffer queue
+    for (x = 0; x < tc.entries.size();) {
+        if (tc.entries[x].pool.expired()) {
+            ris::Pool::ThreadCache::release(tc.entries[x]);
+            tc.entries.erase(tc.entries.begin() + x);
+        } else if (!tc.entries[x].pool.owner_before(entry.pool) && !entry.pool.owner_before(tc.entries[x].pool)) {
+            cacheDrain(&(tc.entries[x].data), 0);
+            tc.entries.erase(tc.entries.begin() + x);
+        } else {
+            x++;
+        }
+    }
+    entry.data.reserve(cacheDepth_);
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mtx_);
+        entry.arena = arenaHold_;
+    }
+    tc.entries.push_back(entry);
+    tc.last = tc.entries.size() - 1;
+    return &(tc.entries[tc.last].data);
+}
+
+//! Refill a thread cache with up to half its depth from the buffer queue
+void ris::Pool::cacheRefill(std::vector<uint8_t*>* cache) {
+    uint32_t count = cacheDepth_ / 2;
+    if (count == 0) count = 1;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    cacheMiss_->inc();
+
+    while (count > 0 && !dataQ_.empty()) {
+        cache->push_back(dataQ_.front());
+        dataQ_.pop();
+        count--;
+    }
+}
+
+//! Drain a thread cache down to keep entries into the buffer queue
+void ris::Pool::cacheDrain(std::vector<uint8_t*>* cache, uint32_t keep) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    cacheMiss_->inc();
+
+    while (cache->size() > keep) {
+        dataQ_.push(cache->back());
+        cache->pop_back();
     }
-    allocBytes_ -= rawSize;
-    allocCount_--;
 }
 
 void ris::Pool::setup_python() {
@@ -107,7 +302,12 @@ void ris::Pool::setup_python() {
         .def("setFixedSize", &ris::Pool::setFixedSize)
         .def("getFixedSize", &ris::Pool::getFixedSize)
         .def("setPoolSize", &ris::Pool::setPoolSize)
-        .def("getPoolSize", &ris::Pool::getPoolSize);
+        .def("getPoolSize", &ris::Pool::getPoolSize)
+        .def("setCacheDepth", &ris::Pool::setCacheDepth)
+        .def("getCacheDepth", &ris::Pool::getCacheDepth)
+        .def("getCacheMissCount", &ris::Pool::getCacheMissCount)
+        .def("setArena", &ris::Pool::setArena)
+        .def("getArenaSize", &ris::Pool::getArenaSize);
 #endif
 }
 
@@ -116,6 +316,9 @@ void ris::Pool::setFixedSize(uint32_t size) {
     rogue::GilRelease noGil;
     std::lock_guard<std::mutex> lock(mtx_);
 
+    if (arenaHold_ && size != fixedSize_)
+        throw(rogue::GeneralError::create("Pool::setFixedSize", "Fixed size can not be changed once an arena is set"));
+
     fixedSize_ = size;
 }
 
@@ -137,9 +340,114 @@ uint32_t ris::Pool::getPoolSize() {
     return poolSize_;
 }
 
+//! Set thread cache depth
+void ris::Pool::setCacheDepth(uint32_t depth) {
+    cacheDepth_ = depth;
+}
+
+//! Get thread cache depth
+uint32_t ris::Pool::getCacheDepth() {
+    return cacheDepth_;
+}
+
+//! Get thread cache miss count
+uint64_t ris::Pool::getCacheMissCount() {
+    return cacheMiss_->get();
+}
+
+//! Allocate buffer arena
+void ris::Pool::setArena(uint64_t size, bool hugePages, int32_t numaNode, bool lock) {
+    std::shared_ptr<rogue::Logging> log = rogue::Logging::create("stream.Pool");
+    std::shared_ptr<ris::Pool::Arena> arena;
+    void* base = MAP_FAILED;
+    uint64_t page;
+    uint64_t stride;
+    uint64_t len;
+    uint32_t x;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> glock(mtx_);
+
+    if (fixedSize_ == 0)
+        throw(rogue::GeneralError::create("Pool::setArena", "Fixed size mode must be enabled before setting an arena"));
+
+    if (arenaHold_) throw(rogue::GeneralError::create("Pool::setArena", "Arena is already set"));
+
+    // Keep each buffer cache line aligned
+    stride = (static_cast<uint64_t>(fixedSize_) + 63) & ~static_cast<uint64_t>(63);
+
+    if (size < stride)
+        throw(rogue::GeneralError::create("Pool::setArena",
+                                          "Arena size %" PRIu64 " is smaller than buffer size %" PRIu64,
+                                          size,
+                                          stride));
+
+    page = sysconf(_SC_PAGESIZE);
+    len  = ((size + page - 1) / page) * page;
+
+#ifdef MAP_HUGETLB
+    if (hugePages) {
+        uint64_t hlen = ((size + HugePageSize - 1) / HugePageSize) * HugePageSize;
+        base          = mmap(NULL, hlen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) len = hlen;
+    }
+#endif
+
+    if (hugePages && base == MAP_FAILED) log->warning("Huge pages are not available, using normal pages");
+
+    if (base == MAP_FAILED) base = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (base == MAP_FAILED)
+        throw(rogue::GeneralError::create("Pool::setArena", "Failed to map arena with size = %" PRIu64, len));
+
+    arena       = std::make_shared<ris::Pool::Arena>();
+    arena->base = reinterpret_cast<uint8_t*>(base);
+    arena->size = len;
+
+    // Bind to the NUMA node before the pages are touched
+    if (numaNode >= 0) {
+#ifdef SYS_mbind
+        uint64_t bits = sizeof(unsigned long) * 8;
+        std::vector<unsigned long> mask(numaNode / bits + 1, 0);
+
+        mask[numaNode / bits] |= 1UL << (numaNode % bits);
+
+        if (syscall(SYS_mbind, base, len, MpolBind, mask.data(), mask.size() * bits + 1, 0) != 0)
+            log->warning("Failed to bind arena to NUMA node %" PRIi32, numaNode);
+#else
+        log->warning("NUMA binding is not supported on this platform");
+#endif
+    }
+
+    // Pre-fault every page
+    memset(base, 0, len);
+
+    if (lock && mlock(base, len) != 0) log->warning("Failed to lock arena in memory");
+
+    arena->count = len / stride;
+    for (x = 0; x < arena->count; x++) dataQ_.push(arena->base + x * stride);
+    freeCount_ += arena->count;
+
+    log->info("Created arena with %" PRIu32 " buffers of %" PRIu32 " bytes", arena->count, fixedSize_.load());
+
+    arenaHold_ = arena;
+    arena_     = arena.get();
+
+    // Thread caches created before the arena do not hold a reference to it, each
+    // thread drains its old cache entry on the next use of the pool
+    poolId_ = poolIdNext_++;
+}
+
+//! Get arena size
+uint32_t ris::Pool::getArenaSize() {
+    Arena* arena = arena_;
+    return ((arena == NULL) ? 0 : arena->count);
+}
+
 //! Allocate a buffer passed size
 // Buffer container and raw data should be allocated from shared memory pool
 ris::BufferPtr ris::Pool::allocBuffer(uint32_t size, uint32_t* total) {
+    std::vector<uint8_t*>* cache;
     uint8_t* data;
     uint32_t bAlloc;
     uint32_t bSize;
@@ -147,29 +455,45 @@ ris::BufferPtr ris::Pool::allocBuffer(uint32_t size, uint32_t* total) {
 
     bAlloc = size;
     bSize  = size;
+    data   = NULL;
 
-    rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(mtx_);
     if (fixedSize_ > 0) {
         bAlloc = fixedSize_;
         if (bSize > bAlloc) bSize = bAlloc;
+
+        // Local cache first, refill from the buffer queue when empty
+        if ((cache = localCache()) != NULL) {
+            if (cache->empty()) cacheRefill(cache);
+
+            if (!cache->empty()) {
+                data = cache->back();
+                cache->pop_back();
+            }
+        } else {
+            rogue::GilRelease noGil;
+            std::lock_guard<std::mutex> lock(mtx_);
+
+            if (dataQ_.size() > 0) {
+                data = dataQ_.front();
+                dataQ_.pop();
+            }
+        }
     }
 
-    if (dataQ_.size() > 0) {
-        data = dataQ_.front();
-        dataQ_.pop();
+    if (data != NULL) {
+        freeCount_--;
     } else if ((data = reinterpret_cast<uint8_t*>(malloc(bAlloc))) == NULL) {
         throw(
             rogue::GeneralError::create("Pool::allocBuffer", "Failed to allocate buffer with size = %" PRIu32, bAlloc));
     }
 
+    if (poolMetricsPend_.load(std::memory_order_relaxed)) publishPoolMetrics();
+
     // Only use lower 24 bits of meta.
     // Upper 8 bits may have special meaning to sub-class
-    meta = allocMeta_;
-    allocMeta_++;
-    allocMeta_ &= 0xFFFFFF;
-    allocBytes_ += bAlloc;
-    allocCount_++;
+    meta = allocMeta_++ & 0xFFFFFF;
+    allocBytes_->add(bAlloc);
+    allocCount_->add(1);
     if (total != NULL) *total += bSize;
     return (ris::Buffer::create(shared_from_this(), data, meta, bSize, bAlloc));
 }
@@ -178,20 +502,31 @@ ris::BufferPtr ris::Pool::allocBuffer(uint32_t size, uint32_t* total) {
 ris::BufferPtr ris::Pool::createBuffer(void* data, uint32_t meta, uint32_t size, uint32_t alloc) {
     ris::BufferPtr buff;
 
-    rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(mtx_);
-
     buff = ris::Buffer::create(shared_from_this(), data, meta, size, alloc);
 
-    allocBytes_ += alloc;
-    allocCount_++;
+    if (poolMetricsPend_.load(std::memory_order_relaxed)) publishPoolMetrics();
+    allocBytes_->add(alloc);
+    allocCount_->add(1);
     return (buff);
 }
 
 //! Track buffer deletion
 void ris::Pool::decCounter(uint32_t alloc) {
-    rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(mtx_);
-    allocBytes_ -= alloc;
-    allocCount_--;
+    allocBytes_->add(-static_cast<int64_t>(alloc));
+    allocCount_->add(-1);
+}
+
+//! Register the allocation metrics
+void ris::Pool::addPoolMetrics(rogue::MetricSetPtr metrics) {
+    poolMetrics_     = metrics;
+    poolMetricsPend_ = true;
+}
+
+//! Register the allocation metrics on first use
+void ris::Pool::publishPoolMetrics() {
+    if (!poolMetricsPend_.exchange(false)) return;
+
+    poolMetrics_->addGauge("allocBytes", allocBytes_);
+    poolMetrics_->addGauge("allocCount", allocCount_);
+    poolMetrics_->addCounter("cacheMiss", cacheMiss_);
 }
@@ -0,0 +1,265 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Stream Frame FIFO with per channel priority scheduling
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/stream/PriorityFifo.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/Threads.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/FrameLock.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace ris = rogue::interfaces::stream;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+ris::PriorityFifoPtr ris::PriorityFifo::create(uint32_t classes, bool weighted) {
+    ris::PriorityFifoPtr p = std::make_shared<ris::PriorityFifo>(classes, weighted);
+    return (p);
+}
+
+//! Setup class in python
+void ris::PriorityFifo::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<ris::PriorityFifo, ris::PriorityFifoPtr, bp::bases<ris::Master, ris::Slave>, boost::noncopyable>(
+        "PriorityFifo",
+        bp::init<uint32_t, bool>())
+        .def("setChannel", &PriorityFifo::setChannel)
+        .def("setClass", &PriorityFifo::setClass)
+        .def("size", &PriorityFifo::size)
+        .def("dropCnt", &PriorityFifo::dropCnt)
+        .def("clearCnt", &PriorityFifo::clearCnt)
+        .def("threads", &PriorityFifo::threads);
+
+    bp::implicitly_convertible<ris::PriorityFifoPtr, ris::MasterPtr>();
+    bp::implicitly_convertible<ris::PriorityFifoPtr, ris::SlavePtr>();
+#endif
+}
+
+//! Creator
+ris::PriorityFifo::PriorityFifo(uint32_t classes, bool weighted)
+    : ris::Master(),
+      ris::Slave(),
+      log_(rogue::Logging::create("stream.PriorityFifo")),
+      weighted_(weighted),
+      count_(0),
+      next_(0),
+      granted_(false),
+      threadEn_(true),
+      threadSet_(rogue::ThreadSet::create("stream.PriorityFifo")) {
+    char name[50];
+    uint32_t x;
+
+    if (classes == 0 || classes > 256)
+        throw(rogue::GeneralError::create("PriorityFifo::PriorityFifo",
+                                          "Invalid class count %" PRIu32 ", must be 1 - 256",
+                                          classes));
+
+    metrics_->setPrefix("stream.PriorityFifo");
+
+    classes_.resize(classes);
+    for (x = 0; x < classes; x++) {
+        classes_[x].maxDepth = 0;
+        classes_[x].weight   = 1;
+        classes_[x].deficit  = 0;
+
+        snprintf(name, sizeof(name), "class%" PRIu32 ".dropCount", x);
+        classes_[x].dropCnt = metrics_->counter(name);
+
+        snprintf(name, sizeof(name), "class%" PRIu32 ".depth", x);
+        classes_[x].depth = metrics_->gauge(name);
+    }
+
+    for (x = 0; x < 256; x++) chanMap_[x] = classes - 1;
+
+    thread_ = threadSet_->start("PriorityFifo", std::bind(&ris::PriorityFifo::runThread, this));
+}
+
+//! Deconstructor
+ris::PriorityFifo::~PriorityFifo() {
+    rogue::GilRelease noGil;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        threadEn_ = false;
+        cond_.notify_all();
+    }
+
+    thread_->join();
+    delete thread_;
+}
+
+//! Map a channel to a class
+void ris::PriorityFifo::setChannel(uint8_t channel, uint32_t cls) {
+    if (cls >= classes_.size())
+        throw(rogue::GeneralError::create("PriorityFifo::setChannel", "Invalid class %" PRIu32, cls));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    chanMap_[channel] = cls;
+}
+
+//! Configure a class
+void ris::PriorityFifo::setClass(uint32_t cls, uint32_t maxDepth, uint32_t weight) {
+    if (cls >= classes_.size())
+        throw(rogue::GeneralError::create("PriorityFifo::setClass", "Invalid class %" PRIu32, cls));
+
+    if (weight == 0) throw(rogue::GeneralError::create("PriorityFifo::setClass", "Weight must be at least 1"));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    classes_[cls].maxDepth = maxDepth;
+    classes_[cls].weight   = weight;
+}
+
+//! Return the number of elements queued for a class
+std::size_t ris::PriorityFifo::size(uint32_t cls) {
+    if (cls >= classes_.size())
+        throw(rogue::GeneralError::create("PriorityFifo::size", "Invalid class %" PRIu32, cls));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return classes_[cls].queue.size();
+}
+
+//! Return the number of dropped frames for a class
+std::size_t ris::PriorityFifo::dropCnt(uint32_t cls) {
+    if (cls >= classes_.size())
+        throw(rogue::GeneralError::create("PriorityFifo::dropCnt", "Invalid class %" PRIu32, cls));
+
+    return classes_[cls].dropCnt->get();
+}
+
+//! Clear counters
+void ris::PriorityFifo::clearCnt() {
+    std::vector<Class>::iterator it;
+
+    for (it = classes_.begin(); it != classes_.end(); ++it) it->dropCnt->set(0);
+}
+
+//! Get the thread set
+rogue::ThreadSetPtr ris::PriorityFifo::threads() {
+    return threadSet_;
+}
+
+//! Accept a frame from master
+void ris::PriorityFifo::acceptFrame(ris::FramePtr frame) {
+    Entry entry;
+    uint8_t chan;
+
+    rogue::GilRelease noGil;
+
+    {
+        ris::FrameLockPtr flock = frame->lock();
+        entry.size = frame->getPayload();
+        chan       = frame->getChannel();
+    }
+    entry.frame = frame;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    Class& cls = classes_[chanMap_[chan]];
+
+    // Class is full, drop frame
+    if (cls.maxDepth != 0 && cls.queue.size() >= cls.maxDepth) {
+        cls.dropCnt->inc();
+        return;
+    }
+
+    cls.queue.push_back(entry);
+    cls.depth->add(1);
+    count_++;
+    cond_.notify_one();
+}
+
+//! Select the next entry to send
+/*
+ * In weighted fair mode this is deficit round robin: each time the scheduler
+ * arrives at a class with queued frames it adds weight * Quantum bytes to the
+ * class deficit, then serves frames while the deficit covers their size before
+ * moving to the next class. An empty class forfeits its deficit.
+ */
+ris::PriorityFifo::Entry ris::PriorityFifo::pop() {
+    Entry entry;
+    uint32_t x;
+
+    if (!weighted_) {
+        for (x = 0; classes_[x].queue.empty(); x++) {}
+
+    } else {
+        for (;;) {
+            Class& cls = classes_[next_];
+
+            if (cls.queue.empty()) {
+                cls.deficit = 0;
+            } else {
+                if (!granted_) {
+                    cls.deficit += static_cast<uint64_t>(cls.weight) * Quantum;
+                    granted_ = true;
+                }
+                if (cls.deficit >= cls.queue.front().size) {
+                    cls.deficit -= cls.queue.front().size;
+                    break;
+                }
+            }
+            next_    = (next_ + 1) % classes_.size();
+            granted_ = false;
+        }
+        x = next_;
+    }
+
+    entry = classes_[x].queue.front();
+    classes_[x].queue.pop_front();
+    classes_[x].depth->add(-1);
+    count_--;
+    return entry;
+}
+
+//! Thread background
+void ris::PriorityFifo::runThread() {
+    Entry entry;
+
+    log_->logThreadId();
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            while (threadEn_ && count_ == 0) cond_.wait(lock);
+            if (!threadEn_) break;
+            entry = pop();
+        }
+
+        sendFrame(entry.frame);
+        entry.frame.reset();
+    }
+}
@@ -27,10 +27,12 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Metrics.h"
 #include "rogue/ScopedGil.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
@@ -53,9 +55,12 @@ ris::SlavePtr ris::Slave::create() {
 
 //! Creator
 ris::Slave::Slave() {
-    debug_      = 0;
-    frameCount_ = 0;
-    frameBytes_ = 0;
+    debug_            = 0;
+    metrics_          = rogue::MetricSet::create("stream.Slave");
+    frameCount_       = rogue::Counter::create();
+    frameBytes_       = rogue::Counter::create();
+    frameMetricsPend_ = true;
+    addPoolMetrics(metrics_);
 }
 
 //! Destructor
@@ -74,13 +79,20 @@ void ris::Slave::acceptFrame(ris::FramePtr frame) {
     ris::FrameIterator it;
 
     uint32_t count;
-    uint8_t val;
+    uint32_t size;
+    uint32_t x;
 
     rogue::GilRelease noGil;
     ris::FrameLockPtr lock = frame->lock();
 
-    frameCount_++;
-    frameBytes_ += frame->getPayload();
+    // Sub-classes which replace acceptFrame() do not publish the unused counters
+    if (frameMetricsPend_.load(std::memory_order_relaxed) && frameMetricsPend_.exchange(false)) {
+        metrics_->addCounter("frameCount", frameCount_);
+        metrics_->addCounter("frameBytes", frameBytes_);
+    }
+
+    frameCount_->inc();
+    frameBytes_->inc(frame->getPayload());
 
     if (debug_ > 0) {
         char buffer[1000];
@@ -89,21 +101,33 @@ void ris::Slave::acceptFrame(ris::FramePtr frame) {
         snprintf(buffer, sizeof(buffer), "     ");
 
         count = 0;
-        for (it = frame->begin(); (count < debug_) && (it != frame->end()); ++it) {
-            count++;
-            val = *it;
-
-            snprintf(buffer + strlen(buffer), 1000 - strlen(buffer), " 0x%.2x", val);
-            if (((count + 1) % 8) == 0) {
-                log_->critical(buffer);
-                snprintf(buffer, sizeof(buffer), "     ");
+        size  = (frame->getPayload() < debug_) ? frame->getPayload() : debug_;
+        it    = frame->begin();
+
+        ris::forEachSpan(it, size, 1, [&](uint8_t* data, uint32_t len) -> bool {
+            for (x = 0; x < len; x++) {
+                count++;
+
+                snprintf(buffer + strlen(buffer), 1000 - strlen(buffer), " 0x%.2x", data[x]);
+                if (((count + 1) % 8) == 0) {
+                    log_->critical(buffer);
+                    snprintf(buffer, sizeof(buffer), "     ");
+                }
             }
-        }
+            return true;
+        });
 
         if (strlen(buffer) > 5) log_->log(100, buffer);
     }
 }
 
+//! Accept a batch of frames from master
+void ris::Slave::acceptFrames(std::vector<ris::FramePtr>& frames) {
+    std::vector<ris::FramePtr>::iterator it;
+
+    for (it = frames.begin(); it != frames.end(); ++it) acceptFrame(*it);
+}
+
 #ifndef NO_PYTHON
 
 //! Accept frame
@@ -132,12 +156,22 @@ void ris::SlaveWrap::defAcceptFrame(ris::FramePtr frame) {
 
 //! Get frame counter
 uint64_t ris::Slave::getFrameCount() {
-    return (frameCount_);
+    return (frameCount_->get());
 }
 
 //! Get byte counter
 uint64_t ris::Slave::getByteCount() {
-    return (frameBytes_);
+    return (frameBytes_->get());
+}
+
+//! Set metrics path
+void ris::Slave::setMetricsPath(const std::string& path) {
+    metrics_->setPath(path);
+}
+
+//! Get metrics path
+std::string ris::Slave::getMetricsPath() {
+    return metrics_->getPath();
 }
 
 // Ensure passed frame is a single buffer
@@ -182,6 +216,8 @@ void ris::Slave::setup_python() {
         .def("_acceptFrame", &ris::Slave::acceptFrame, &ris::SlaveWrap::defAcceptFrame)
         .def("getFrameCount", &ris::Slave::getFrameCount)
         .def("getByteCount", &ris::Slave::getByteCount)
+        .def("setMetricsPath", &ris::Slave::setMetricsPath)
+        .def("getMetricsPath", &ris::Slave::getMetricsPath)
         .def("_stop", &ris::Slave::stop)
         .def("getAllocCount", &ris::Pool::getAllocCount)
         .def("getAllocBytes", &ris::Pool::getAllocBytes)
@@ -189,6 +225,11 @@ void ris::Slave::setup_python() {
         .def("getFixedSize", &ris::Pool::getFixedSize)
         .def("setPoolSize", &ris::Pool::setPoolSize)
         .def("getPoolSize", &ris::Pool::getPoolSize)
+        .def("setCacheDepth", &ris::Pool::setCacheDepth)
+        .def("getCacheDepth", &ris::Pool::getCacheDepth)
+        .def("getCacheMissCount", &ris::Pool::getCacheMissCount)
+        .def("setArena", &ris::Pool::setArena)
+        .def("getArenaSize", &ris::Pool::getArenaSize)
         .def("__lshift__", &ris::Slave::lshiftPy);
 
     bp::implicitly_convertible<ris::SlavePtr, ris::PoolPtr>();
@@ -0,0 +1,146 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Lossy stream monitoring tap
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/stream/Tap.h"
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/Threads.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace ris = rogue::interfaces::stream;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+ris::TapPtr ris::Tap::create() {
+    ris::TapPtr p = std::make_shared<ris::Tap>();
+    return (p);
+}
+
+//! Setup class in python
+void ris::Tap::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<ris::Tap, ris::TapPtr, bp::bases<ris::Master, ris::Slave>, boost::noncopyable>("Tap", bp::init<>())
+        .def("skipCnt", &Tap::skipCnt)
+        .def("clearCnt", &Tap::clearCnt)
+        .def("threads", &Tap::threads);
+
+    bp::implicitly_convertible<ris::TapPtr, ris::MasterPtr>();
+    bp::implicitly_convertible<ris::TapPtr, ris::SlavePtr>();
+#endif
+}
+
+//! Creator
+ris::Tap::Tap()
+    : ris::Master(),
+      ris::Slave(),
+      log_(rogue::Logging::create("stream.Tap")),
+      threadEn_(true),
+      threadSet_(rogue::ThreadSet::create("stream.Tap")) {
+    metrics_->setPrefix("stream.Tap");
+    skipCnt_ = metrics_->counter("skipCount");
+
+    thread_ = threadSet_->start("Tap", std::bind(&ris::Tap::runThread, this));
+}
+
+//! Deconstructor
+ris::Tap::~Tap() {
+    rogue::GilRelease noGil;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        threadEn_ = false;
+        cond_.notify_all();
+    }
+
+    thread_->join();
+    delete thread_;
+}
+
+//! Get the number of skipped frames
+uint64_t ris::Tap::skipCnt() {
+    return skipCnt_->get();
+}
+
+//! Clear skip counter
+void ris::Tap::clearCnt() {
+    skipCnt_->set(0);
+}
+
+//! Get the thread set
+rogue::ThreadSetPtr ris::Tap::threads() {
+    return threadSet_;
+}
+
+//! Accept a frame from master
+void ris::Tap::acceptFrame(ris::FramePtr frame) {
+    ris::FramePtr old;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    // Replace the held frame, it is released after the lock
+    if (slot_) skipCnt_->inc();
+    old.swap(slot_);
+    slot_ = frame;
+    cond_.notify_one();
+}
+
+//! Accept a batch of frames from master
+void ris::Tap::acceptFrames(std::vector<ris::FramePtr>& frames) {
+    if (frames.empty()) return;
+
+    // Only the last frame of a batch can be forwarded
+    skipCnt_->inc(frames.size() - 1);
+    acceptFrame(frames.back());
+}
+
+//! Thread background
+void ris::Tap::runThread() {
+    ris::FramePtr frame;
+
+    log_->logThreadId();
+
+    while (threadEn_) {
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+
+            while (threadEn_ && !slot_) cond_.wait(lock);
+            frame.swap(slot_);
+        }
+
+        if (frame) {
+            sendFrame(frame);
+            frame.reset();
+        }
+    }
+}
@@ -22,12 +22,14 @@
 #include <zmq.h>
 
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
@@ -61,6 +63,7 @@ ris::TcpCore::TcpCore(const std::string& addr, uint16_t port, bool server) {
     logstr.append(std::to_string(port));
 
     this->bridgeLog_ = rogue::Logging::create(logstr);
+    this->threadSet_ = rogue::ThreadSet::create("stream.TcpCore");
 
     // Format address
     this->pullAddr_ = "tcp://";
@@ -135,12 +138,7 @@ ris::TcpCore::TcpCore(const std::string& addr, uint16_t port, bool server) {
 
     // Start rx thread
     threadEn_     = true;
-    this->thread_ = new std::thread(&ris::TcpCore::runThread, this);
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "TcpCore");
-#endif
+    this->thread_ = threadSet_->start("TcpCore", std::bind(&ris::TcpCore::runThread, this));
 }
 
 //! Destructor
@@ -164,6 +162,11 @@ void ris::TcpCore::stop() {
     }
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr ris::TcpCore::threads() {
+    return threadSet_;
+}
+
 //! Accept a frame from master
 void ris::TcpCore::acceptFrame(ris::FramePtr frame) {
     uint32_t x;
@@ -280,6 +283,7 @@ void ris::TcpCore::runThread() {
             frame->setFlags(flags);
             frame->setChannel(chan);
             frame->setError(err);
+            frame->stamp();
 
             bridgeLog_->debug("Pulled frame with size %" PRIu32, frame->getPayload());
             sendFrame(frame);
@@ -294,7 +298,8 @@ void ris::TcpCore::setup_python() {
 
     bp::class_<ris::TcpCore, ris::TcpCorePtr, bp::bases<ris::Master, ris::Slave>, boost::noncopyable>("TcpCore",
                                                                                                       bp::no_init)
-        .def("close", &ris::TcpCore::close);
+        .def("close", &ris::TcpCore::close)
+        .def("threads", &ris::TcpCore::threads);
 
     bp::implicitly_convertible<ris::TcpCorePtr, ris::MasterPtr>();
     bp::implicitly_convertible<ris::TcpCorePtr, ris::SlavePtr>();
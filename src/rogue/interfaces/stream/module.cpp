@@ -21,13 +21,18 @@
 
 #include <boost/python.hpp>
 
+#include "rogue/interfaces/stream/BatchSlave.h"
+#include "rogue/interfaces/stream/Demux.h"
 #include "rogue/interfaces/stream/Fifo.h"
 #include "rogue/interfaces/stream/Filter.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
 #include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/ParallelFifo.h"
+#include "rogue/interfaces/stream/PriorityFifo.h"
 #include "rogue/interfaces/stream/RateDrop.h"
 #include "rogue/interfaces/stream/Slave.h"
+#include "rogue/interfaces/stream/Tap.h"
 #include "rogue/interfaces/stream/TcpClient.h"
 #include "rogue/interfaces/stream/TcpCore.h"
 #include "rogue/interfaces/stream/TcpServer.h"
@@ -52,9 +57,14 @@ void ris::setup_module() {
     ris::Slave::setup_python();
     ris::Pool::setup_python();
     ris::Fifo::setup_python();
+    ris::ParallelFifo::setup_python();
+    ris::PriorityFifo::setup_python();
     ris::Filter::setup_python();
+    ris::Demux::setup_python();
     ris::TcpCore::setup_python();
     ris::TcpClient::setup_python();
     ris::TcpServer::setup_python();
     ris::RateDrop::setup_python();
+    ris::Tap::setup_python();
+    ris::BatchSlave::setup_python();
 }
@@ -22,7 +22,11 @@
 #include <boost/python.hpp>
 
 #include "rogue/GeneralError.h"
+#include "rogue/Histogram.h"
 #include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Reactor.h"
+#include "rogue/Threads.h"
 #include "rogue/Version.h"
 #include "rogue/hardware/module.h"
 #include "rogue/interfaces/module.h"
@@ -38,6 +42,10 @@ void rogue::setup_module() {
     rogue::utilities::setup_module();
 
     rogue::GeneralError::setup_python();
+    rogue::Histogram::setup_python();
     rogue::Logging::setup_python();
+    rogue::Metrics::setup_python();
+    rogue::Reactor::setup_python();
+    rogue::Threads::setup_python();
     rogue::Version::setup_python();
 }
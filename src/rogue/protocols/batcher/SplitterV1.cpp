@@ -79,13 +79,8 @@ void rpb::SplitterV1::acceptFrame(ris::FramePtr frame) {
     for (x = 0; x < core.count(); x++) {
         data = core.record(x);
 
-        // Create a new frame
-        nFrame = reqFrame(data->size(), true);
-        nFrame->setPayload(data->size());
-
-        ris::FrameIterator fIter = nFrame->begin();
-        ris::FrameIterator dIter = data->begin();
-        ris::copyFrame(dIter, data->size(), fIter);
+        // Create a new frame which references the record data in place
+        nFrame = frame->slice(data->begin() - frame->begin(), data->size());
 
         // Set flags
         nFrame->setFirstUser(data->fUser());
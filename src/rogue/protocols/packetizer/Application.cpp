@@ -18,11 +18,13 @@
 
 #include "rogue/protocols/packetizer/Application.h"
 
+#include <functional>
 #include <memory>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/protocols/packetizer/Controller.h"
@@ -54,7 +56,7 @@ void rpp::Application::setup_python() {
 }
 
 //! Creator
-rpp::Application::Application(uint8_t id) {
+rpp::Application::Application(uint8_t id) : queue_(8) {
     id_ = id;
     queue_.setMax(8);
 }
@@ -73,12 +75,7 @@ void rpp::Application::setController(rpp::ControllerPtr cntl) {
 
     // Start read thread
     threadEn_ = true;
-    thread_   = new std::thread(&rpp::Application::runThread, this);
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "PackApp");
-#endif
+    thread_   = cntl_->threads()->start("PackApp", std::bind(&rpp::Application::runThread, this));
 }
 
 //! Generate a Frame. Called from master
@@ -24,6 +24,8 @@
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Helpers.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
@@ -48,9 +50,11 @@ rpp::Controller::Controller(rpp::TransportPtr tran,
     appIndex_  = 0;
     tranIndex_ = 0;
     tranDest_  = 0;
-    dropCount_ = 0;
     tranQueue_.setThold(64);
-    log_ = rogue::Logging::create("packetizer.Controller");
+    log_       = rogue::Logging::create("packetizer.Controller");
+    metrics_   = rogue::MetricSet::create("packetizer.Controller");
+    dropCount_ = metrics_->counter("dropCount");
+    threadSet_ = rogue::ThreadSet::create("packetizer.Controller");
 
     rogue::defaultTimeout(timeout_);
 
@@ -139,7 +143,7 @@ void rpp::Controller::applicationRx(ris::FramePtr frame, uint8_t tDest) {}
 
 //! Get drop count
 uint32_t rpp::Controller::getDropCount() {
-    return (dropCount_);
+    return (dropCount_->get());
 }
 
 //! Set timeout for frame transmits in microseconds
@@ -148,3 +152,8 @@ void rpp::Controller::setTimeout(uint32_t timeout) {
     timeout_.tv_sec  = divResult.quot;
     timeout_.tv_usec = divResult.rem;
 }
+
+//! Get the thread set
+rogue::ThreadSetPtr rpp::Controller::threads() {
+    return threadSet_;
+}
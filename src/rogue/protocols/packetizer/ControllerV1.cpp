@@ -83,7 +83,7 @@ void rpp::ControllerV1::transportRx(ris::FramePtr frame) {
                       size,
                       frame->bufferCount(),
                       data[0] & 0xF);
-        dropCount_++;
+        dropCount_->inc();
         return;
     }
 
@@ -137,7 +137,7 @@ void rpp::ControllerV1::transportRx(ris::FramePtr frame) {
                       tmpIdx,
                       tranCount_[0],
                       tmpCount);
-        dropCount_++;
+        dropCount_->inc();
         tranCount_[0] = 0;
         tranFrame_[0].reset();
         return;
@@ -108,7 +108,7 @@ void rpp::ControllerV2::transportRx(ris::FramePtr frame) {
                       size,
                       frame->bufferCount(),
                       data[0] & 0xF);
-        dropCount_++;
+        dropCount_->inc();
         return;
     }
 
@@ -194,7 +194,7 @@ void rpp::ControllerV2::transportRx(ris::FramePtr frame) {
                       crcErr,
                       tranCount_[tmpDest],
                       tmpCount);
-        dropCount_++;
+        dropCount_->inc();
         transSof_[tmpDest]  = true;
         tranCount_[tmpDest] = 0;
         tranFrame_[tmpDest].reset();
@@ -212,7 +212,7 @@ void rpp::ControllerV2::transportRx(ris::FramePtr frame) {
                           crcErr,
                           tranCount_[tmpDest],
                           tmpCount);
-            dropCount_++;
+            dropCount_->inc();
             transSof_[tmpDest]  = true;
             tranCount_[tmpDest] = 0;
             tranFrame_[tmpDest].reset();
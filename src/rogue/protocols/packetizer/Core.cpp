@@ -22,6 +22,7 @@
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Threads.h"
 #include "rogue/protocols/packetizer/Application.h"
 #include "rogue/protocols/packetizer/ControllerV1.h"
 #include "rogue/protocols/packetizer/Transport.h"
@@ -46,7 +47,8 @@ void rpp::Core::setup_python() {
     bp::class_<rpp::Core, rpp::CorePtr, boost::noncopyable>("Core", bp::init<bool>())
         .def("transport", &rpp::Core::transport)
         .def("application", &rpp::Core::application)
-        .def("getDropCount", &rpp::Core::getDropCount);
+        .def("getDropCount", &rpp::Core::getDropCount)
+        .def("threads", &rpp::Core::threads);
 #endif
 }
 
@@ -90,3 +92,8 @@ uint32_t rpp::Core::getDropCount() {
 void rpp::Core::setTimeout(uint32_t timeout) {
     cntl_->setTimeout(timeout);
 }
+
+//! Get the thread set
+rogue::ThreadSetPtr rpp::Core::threads() {
+    return (cntl_->threads());
+}
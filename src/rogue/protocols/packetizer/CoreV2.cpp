@@ -22,6 +22,7 @@
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Threads.h"
 #include "rogue/protocols/packetizer/Application.h"
 #include "rogue/protocols/packetizer/ControllerV2.h"
 #include "rogue/protocols/packetizer/Transport.h"
@@ -46,7 +47,8 @@ void rpp::CoreV2::setup_python() {
     bp::class_<rpp::CoreV2, rpp::CoreV2Ptr, boost::noncopyable>("CoreV2", bp::init<bool, bool, bool>())
         .def("transport", &rpp::CoreV2::transport)
         .def("application", &rpp::CoreV2::application)
-        .def("getDropCount", &rpp::CoreV2::getDropCount);
+        .def("getDropCount", &rpp::CoreV2::getDropCount)
+        .def("threads", &rpp::CoreV2::threads);
 #endif
 }
 
@@ -90,3 +92,8 @@ uint32_t rpp::CoreV2::getDropCount() {
 void rpp::CoreV2::setTimeout(uint32_t timeout) {
     cntl_->setTimeout(timeout);
 }
+
+//! Get the thread set
+rogue::ThreadSetPtr rpp::CoreV2::threads() {
+    return (cntl_->threads());
+}
@@ -18,11 +18,13 @@
 
 #include "rogue/protocols/packetizer/Transport.h"
 
+#include <functional>
 #include <memory>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/protocols/packetizer/Controller.h"
@@ -68,12 +70,7 @@ void rpp::Transport::setController(rpp::ControllerPtr cntl) {
 
     // Start read thread
     threadEn_ = true;
-    thread_   = new std::thread(&rpp::Transport::runThread, this);
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "PackTrans");
-#endif
+    thread_   = cntl_->threads()->start("PackTrans", std::bind(&rpp::Transport::runThread, this));
 }
 
 //! Accept a frame from master
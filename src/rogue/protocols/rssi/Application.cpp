@@ -18,11 +18,13 @@
 
 #include "rogue/protocols/rssi/Application.h"
 
+#include <functional>
 #include <memory>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/protocols/rssi/Controller.h"
@@ -69,12 +71,7 @@ void rpr::Application::setController(rpr::ControllerPtr cntl) {
 
     // Start read thread
     threadEn_ = true;
-    thread_   = new std::thread(&rpr::Application::runThread, this);
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "RssiApp");
-#endif
+    thread_   = cntl_->threads()->start("RssiApp", std::bind(&rpr::Application::runThread, this));
 }
 
 //! Generate a Frame. Called from master
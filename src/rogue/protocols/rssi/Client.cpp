@@ -22,6 +22,7 @@
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Threads.h"
 #include "rogue/protocols/rssi/Application.h"
 #include "rogue/protocols/rssi/Controller.h"
 #include "rogue/protocols/rssi/Transport.h"
@@ -79,6 +80,7 @@ void rpr::Client::setup_python() {
         .def("curMaxCumAck", &rpr::Client::curMaxCumAck)
         .def("resetCounters", &rpr::Client::resetCounters)
         .def("setTimeout", &rpr::Client::setTimeout)
+        .def("threads", &rpr::Client::threads)
         .def("_stop", &rpr::Client::stop)
         .def("_start", &rpr::Client::start);
 #endif
@@ -250,6 +252,11 @@ void rpr::Client::setTimeout(uint32_t timeout) {
     cntl_->setTimeout(timeout);
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rpr::Client::threads() {
+    return (cntl_->threads());
+}
+
 //! Send reset and close
 void rpr::Client::stop() {
     return (cntl_->stop());
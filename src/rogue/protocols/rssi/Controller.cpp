@@ -23,6 +23,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <map>
 #include <memory>
 #include <utility>
@@ -31,6 +32,8 @@
 #include "rogue/GilRelease.h"
 #include "rogue/Helpers.h"
 #include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
@@ -61,7 +64,6 @@ rpr::Controller::Controller(uint32_t segSize, rpr::TransportPtr tran, rpr::Appli
     // Busy after two entries
     appQueue_.setThold(2);
 
-    dropCount_ = 0;
     nextSeqRx_ = 0;
     lastAckRx_ = 0;
     locBusy_   = false;
@@ -72,8 +74,7 @@ rpr::Controller::Controller(uint32_t segSize, rpr::TransportPtr tran, rpr::Appli
 
     state_ = StClosed;
     gettimeofday(&stTime_, NULL);
-    downCount_   = 0;
-    retranCount_ = 0;
+    downCount_ = 0;
 
     txListCount_ = 0;
     lastAckTx_   = 0;
@@ -115,7 +116,12 @@ rpr::Controller::Controller(uint32_t segSize, rpr::TransportPtr tran, rpr::Appli
 
     log_ = rogue::Logging::create("rssi.controller");
 
-    thread_ = NULL;
+    metrics_     = rogue::MetricSet::create("rssi.Controller");
+    dropCount_   = metrics_->counter("dropCount");
+    retranCount_ = metrics_->counter("retranCount");
+
+    threadSet_ = rogue::ThreadSet::create("rssi.Controller");
+    thread_    = NULL;
 }
 
 //! Destructor
@@ -145,12 +151,7 @@ void rpr::Controller::start() {
     if (thread_ == NULL) {
         state_    = StClosed;
         threadEn_ = true;
-        thread_   = new std::thread(&rpr::Controller::runThread, this);
-
-        // Set a thread name
-#ifndef __MACH__
-        pthread_setname_np(thread_->native_handle(), "RssiControler");
-#endif
+        thread_   = threadSet_->start("RssiControler", std::bind(&rpr::Controller::runThread, this));
     }
 }
 
@@ -200,7 +201,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
 
     if (frame->getError() || frame->isEmpty() || !head->verify()) {
         log_->warning("Dumping bad frame state=%" PRIu32 " server=%" PRIu32, state_, server_);
-        dropCount_++;
+        dropCount_->inc();
         return;
     }
 
@@ -268,7 +269,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
                                   server_,
                                   head->sequence,
                                   nextSeqRx_);
-                    dropCount_++;
+                    dropCount_->inc();
                     oooQueue_.erase(it);
                 }
 
@@ -297,7 +298,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
                           server_,
                           head->sequence,
                           nextSeqRx_);
-            dropCount_++;
+            dropCount_->inc();
 
             // Add to out of order queue in case things arrive out of order
             // Make sure received sequence is in window. There may be a better way
@@ -326,7 +327,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
                               head->sequence,
                               nextSeqRx_,
                               windowEnd);
-                dropCount_++;
+                dropCount_->inc();
             }
         }
     }
@@ -423,12 +424,12 @@ uint32_t rpr::Controller::getDownCount() {
 
 //! Get Drop Count
 uint32_t rpr::Controller::getDropCount() {
-    return (dropCount_);
+    return (dropCount_->get());
 }
 
 //! Get Retransmit Count
 uint32_t rpr::Controller::getRetranCount() {
-    return (retranCount_);
+    return (retranCount_->get());
 }
 
 //! Get locBusy
@@ -580,11 +581,11 @@ uint8_t rpr::Controller::curMaxCumAck() {
 }
 
 void rpr::Controller::resetCounters() {
-    dropCount_   = 0;
-    downCount_   = 0;
-    retranCount_ = 0;
-    locBusyCnt_  = 0;
-    remBusyCnt_  = 0;
+    dropCount_->set(0);
+    retranCount_->set(0);
+    downCount_  = 0;
+    locBusyCnt_ = 0;
+    remBusyCnt_ = 0;
 }
 
 // Method to transit a frame with proper updates
@@ -634,7 +635,7 @@ void rpr::Controller::transportTx(rpr::HeaderPtr head, bool seqUpdate, bool txRe
               head->rst,
               head->acknowledge,
               head->sequence,
-              retranCount_,
+              static_cast<uint32_t>(retranCount_->get()),
               head->getFrame().get());
 
     flock->unlock();
@@ -657,7 +658,7 @@ int8_t rpr::Controller::retransmit(uint8_t id) {
     // max retransmission count has been reached
     if (head->count() >= curMaxRetran_) return -1;
 
-    retranCount_++;
+    retranCount_->inc();
 
     if (getLocBusy()) {
         head->acknowledge = lastAckTx_;
@@ -683,7 +684,7 @@ int8_t rpr::Controller::retransmit(uint8_t id) {
               head->rst,
               head->acknowledge,
               head->sequence,
-              retranCount_,
+              static_cast<uint32_t>(retranCount_->get()),
               head->getFrame().get());
 
     ris::FrameLockPtr flock = head->getFrame()->lock();
@@ -982,3 +983,8 @@ void rpr::Controller::setTimeout(uint32_t timeout) {
     timeout_.tv_sec  = divResult.quot;
     timeout_.tv_usec = divResult.rem;
 }
+
+//! Get the thread set
+rogue::ThreadSetPtr rpr::Controller::threads() {
+    return threadSet_;
+}
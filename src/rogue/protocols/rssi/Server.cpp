@@ -22,6 +22,7 @@
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/Threads.h"
 #include "rogue/protocols/rssi/Application.h"
 #include "rogue/protocols/rssi/Controller.h"
 #include "rogue/protocols/rssi/Transport.h"
@@ -79,6 +80,7 @@ void rpr::Server::setup_python() {
         .def("curMaxCumAck", &rpr::Server::curMaxCumAck)
         .def("resetCounters", &rpr::Server::resetCounters)
         .def("setTimeout", &rpr::Server::setTimeout)
+        .def("threads", &rpr::Server::threads)
         .def("_stop", &rpr::Server::stop)
         .def("_start", &rpr::Server::start);
 #endif
@@ -250,6 +252,11 @@ void rpr::Server::setTimeout(uint32_t timeout) {
     cntl_->setTimeout(timeout);
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rpr::Server::threads() {
+    return (cntl_->threads());
+}
+
 //! Send reset and close
 void rpr::Server::stop() {
     return (cntl_->stop());
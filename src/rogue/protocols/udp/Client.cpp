@@ -23,12 +23,16 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Reactor.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
@@ -57,9 +61,10 @@ rpu::Client::Client(std::string host, uint16_t port, bool jumbo) : rpu::Core(jum
     int32_t ret;
     uint32_t size;
 
-    address_ = host;
-    port_    = port;
-    udpLog_  = rogue::Logging::create("udp.Client");
+    address_   = host;
+    port_      = port;
+    udpLog_    = rogue::Logging::create("udp.Client");
+    threadSet_ = rogue::ThreadSet::create("udp.Client");
 
     // Create a shared pointer to use as a lock for runThread()
     std::shared_ptr<int> scopePtr = std::make_shared<int>(0);
@@ -95,12 +100,7 @@ rpu::Client::Client(std::string host, uint16_t port, bool jumbo) : rpu::Core(jum
 
     // Start rx thread
     threadEn_ = true;
-    thread_   = new std::thread(&rpu::Client::runThread, this, std::weak_ptr<int>(scopePtr));
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "UdpClient");
-#endif
+    thread_   = threadSet_->start("UdpClient", std::bind(&rpu::Client::runThread, this, std::weak_ptr<int>(scopePtr)));
 }
 
 //! Destructor
@@ -109,7 +109,12 @@ rpu::Client::~Client() {
 }
 
 void rpu::Client::stop() {
-    if (threadEn_) {
+    if (reactor_) {
+        reactor_->remove(fd_);
+        reactor_.reset();
+
+        ::close(fd_);
+    } else if (threadEn_) {
         threadEn_ = false;
         thread_->join();
 
@@ -117,6 +122,23 @@ void rpu::Client::stop() {
     }
 }
 
+//! Receive using a shared reactor
+void rpu::Client::setReactor(rogue::ReactorPtr reactor) {
+    rogue::GilRelease noGil;
+
+    if (reactor_ || !threadEn_)
+        throw(rogue::GeneralError::create("Client::setReactor", "Interface is stopped or already uses a reactor"));
+
+    // Retire the receive thread, the reactor reads from here on
+    threadEn_ = false;
+    thread_->join();
+    delete thread_;
+    thread_ = NULL;
+
+    reactor_ = reactor;
+    reactor_->add(fd_, std::bind(&rpu::Client::rxReady, this));
+}
+
 //! Accept a frame from master
 void rpu::Client::acceptFrame(ris::FramePtr frame) {
     ris::Frame::BufferIterator it;
@@ -181,6 +203,7 @@ void rpu::Client::acceptFrame(ris::FramePtr frame) {
 void rpu::Client::runThread(std::weak_ptr<int> lockPtr) {
     ris::BufferPtr buff;
     ris::FramePtr frame;
+    std::vector<ris::FramePtr> frames;
     fd_set fds;
     int32_t res;
     struct timeval tout;
@@ -193,12 +216,13 @@ void rpu::Client::runThread(std::weak_ptr<int> lockPtr) {
 
     // Preallocate frame
     frame = reqLocalFrame(maxPayload(), false);
+    frames.reserve(RxBatchSize);
 
     while (threadEn_) {
-        // Attempt receive
+        // Attempt receive without blocking, the select below waits for data
         buff  = *(frame->beginBuffer());
         avail = buff->getAvailable();
-        res   = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC, NULL, 0);
+        res   = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC | MSG_DONTWAIT, NULL, 0);
 
         if (res > 0) {
             // Message was too big
@@ -206,11 +230,23 @@ void rpu::Client::runThread(std::weak_ptr<int> lockPtr) {
                 udpLog_->warning("Receive data was too large. Rx=%i, avail=%i Dropping.", res, avail);
             } else {
                 buff->setPayload(res);
-                sendFrame(frame);
+                frame->stamp();
+                frames.push_back(frame);
             }
 
             // Get new frame
             frame = reqLocalFrame(maxPayload(), false);
+
+            // Forward a full batch
+            if (frames.size() >= RxBatchSize) {
+                sendFrames(frames);
+                frames.clear();
+            }
+        } else if (!frames.empty()) {
+            // Socket is drained, forward the pending batch before waiting
+            sendFrames(frames);
+            frames.clear();
+
         } else {
             // Setup fds for select call
             FD_ZERO(&fds);
@@ -226,12 +262,53 @@ void rpu::Client::runThread(std::weak_ptr<int> lockPtr) {
     }
 }
 
+//! Receive from the reactor, read until the socket would block
+void rpu::Client::rxReady() {
+    ris::BufferPtr buff;
+    ris::FramePtr frame;
+    std::vector<ris::FramePtr> frames;
+    int32_t res;
+    uint32_t avail;
+
+    frame = reqLocalFrame(maxPayload(), false);
+    frames.reserve(RxBatchSize);
+
+    for (;;) {
+        buff  = *(frame->beginBuffer());
+        avail = buff->getAvailable();
+
+        if ((res = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC | MSG_DONTWAIT, NULL, 0)) < 0) break;
+        if (res == 0) continue;
+
+        // Message was too big
+        if (static_cast<uint32_t>(res) > avail) {
+            udpLog_->warning("Receive data was too large. Rx=%i, avail=%i Dropping.", res, avail);
+        } else {
+            buff->setPayload(res);
+            frame->stamp();
+            frames.push_back(frame);
+        }
+
+        // Get new frame
+        frame = reqLocalFrame(maxPayload(), false);
+
+        // Forward a full batch
+        if (frames.size() >= RxBatchSize) {
+            sendFrames(frames);
+            frames.clear();
+        }
+    }
+
+    if (!frames.empty()) sendFrames(frames);
+}
+
 void rpu::Client::setup_python() {
 #ifndef NO_PYTHON
 
     bp::class_<rpu::Client, rpu::ClientPtr, bp::bases<rpu::Core, ris::Master, ris::Slave>, boost::noncopyable>(
         "Client",
-        bp::init<std::string, uint16_t, bool>());
+        bp::init<std::string, uint16_t, bool>())
+        .def("setReactor", &rpu::Client::setReactor);
 
     bp::implicitly_convertible<rpu::ClientPtr, rpu::CorePtr>();
     bp::implicitly_convertible<rpu::ClientPtr, ris::MasterPtr>();
@@ -24,6 +24,7 @@
 #include "rogue/GeneralError.h"
 #include "rogue/Helpers.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 
 namespace rpu = rogue::protocols::udp;
 
@@ -75,11 +76,17 @@ void rpu::Core::setTimeout(uint32_t timeout) {
     timeout_.tv_usec = divResult.rem;
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rpu::Core::threads() {
+    return threadSet_;
+}
+
 void rpu::Core::setup_python() {
 #ifndef NO_PYTHON
     bp::class_<rpu::Core, rpu::CorePtr, boost::noncopyable>("Core", bp::no_init)
         .def("maxPayload", &rpu::Core::maxPayload)
         .def("setRxBufferCount", &rpu::Core::setRxBufferCount)
-        .def("setTimeout", &rpu::Core::setTimeout);
+        .def("setTimeout", &rpu::Core::setTimeout)
+        .def("threads", &rpu::Core::threads);
 #endif
 }
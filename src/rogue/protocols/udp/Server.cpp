@@ -23,12 +23,16 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Reactor.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
@@ -54,8 +58,9 @@ rpu::Server::Server(uint16_t port, bool jumbo) : rpu::Core(jumbo) {
     int32_t val;
     uint32_t size;
 
-    port_   = port;
-    udpLog_ = rogue::Logging::create("udp.Server");
+    port_      = port;
+    udpLog_    = rogue::Logging::create("udp.Server");
+    threadSet_ = rogue::ThreadSet::create("udp.Server");
 
     // Create a shared pointer to use as a lock for runThread()
     std::shared_ptr<int> scopePtr = std::make_shared<int>(0);
@@ -91,12 +96,7 @@ rpu::Server::Server(uint16_t port, bool jumbo) : rpu::Core(jumbo) {
 
     // Start rx thread
     threadEn_ = true;
-    thread_   = new std::thread(&rpu::Server::runThread, this, std::weak_ptr<int>(scopePtr));
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "UdpServer");
-#endif
+    thread_   = threadSet_->start("UdpServer", std::bind(&rpu::Server::runThread, this, std::weak_ptr<int>(scopePtr)));
 }
 
 //! Destructor
@@ -105,7 +105,12 @@ rpu::Server::~Server() {
 }
 
 void rpu::Server::stop() {
-    if (threadEn_) {
+    if (reactor_) {
+        reactor_->remove(fd_);
+        reactor_.reset();
+
+        ::close(fd_);
+    } else if (threadEn_) {
         threadEn_ = false;
         thread_->join();
 
@@ -113,6 +118,23 @@ void rpu::Server::stop() {
     }
 }
 
+//! Receive using a shared reactor
+void rpu::Server::setReactor(rogue::ReactorPtr reactor) {
+    rogue::GilRelease noGil;
+
+    if (reactor_ || !threadEn_)
+        throw(rogue::GeneralError::create("Server::setReactor", "Interface is stopped or already uses a reactor"));
+
+    // Retire the receive thread, the reactor reads from here on
+    threadEn_ = false;
+    thread_->join();
+    delete thread_;
+    thread_ = NULL;
+
+    reactor_ = reactor;
+    reactor_->add(fd_, std::bind(&rpu::Server::rxReady, this));
+}
+
 //! Get port number
 uint32_t rpu::Server::getPort() {
     return (port_);
@@ -182,6 +204,7 @@ void rpu::Server::acceptFrame(ris::FramePtr frame) {
 void rpu::Server::runThread(std::weak_ptr<int> lockPtr) {
     ris::BufferPtr buff;
     ris::FramePtr frame;
+    std::vector<ris::FramePtr> frames;
     fd_set fds;
     int32_t res;
     struct timeval tout;
@@ -196,31 +219,44 @@ void rpu::Server::runThread(std::weak_ptr<int> lockPtr) {
 
     // Preallocate frame
     frame = reqLocalFrame(maxPayload(), false);
+    frames.reserve(RxBatchSize);
 
     while (threadEn_) {
-        // Attempt receive
+        // Attempt receive without blocking, the select below waits for data
         buff   = *(frame->beginBuffer());
         avail  = buff->getAvailable();
         tmpLen = sizeof(struct sockaddr_in);
-        res    = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC, (struct sockaddr*)&tmpAddr, &tmpLen);
+        res    = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC | MSG_DONTWAIT, (struct sockaddr*)&tmpAddr, &tmpLen);
 
         if (res > 0) {
+            // Lock before updating address, update before forwarding so replies reach the sender
+            if (memcmp(&remAddr_, &tmpAddr, sizeof(remAddr_)) != 0) {
+                std::lock_guard<std::mutex> lock(udpMtx_);
+                remAddr_ = tmpAddr;
+            }
+
             // Message was too big
             if (res > avail) {
                 udpLog_->warning("Receive data was too large. Dropping.");
             } else {
                 buff->setPayload(res);
-                sendFrame(frame);
+                frame->stamp();
+                frames.push_back(frame);
             }
 
             // Get new frame
             frame = reqLocalFrame(maxPayload(), false);
 
-            // Lock before updating address
-            if (memcmp(&remAddr_, &tmpAddr, sizeof(remAddr_)) != 0) {
-                std::lock_guard<std::mutex> lock(udpMtx_);
-                remAddr_ = tmpAddr;
+            // Forward a full batch
+            if (frames.size() >= RxBatchSize) {
+                sendFrames(frames);
+                frames.clear();
             }
+        } else if (!frames.empty()) {
+            // Socket is drained, forward the pending batch before waiting
+            sendFrames(frames);
+            frames.clear();
+
         } else {
             // Setup fds for select call
             FD_ZERO(&fds);
@@ -236,13 +272,64 @@ void rpu::Server::runThread(std::weak_ptr<int> lockPtr) {
     }
 }
 
+//! Receive from the reactor, read until the socket would block
+void rpu::Server::rxReady() {
+    ris::BufferPtr buff;
+    ris::FramePtr frame;
+    std::vector<ris::FramePtr> frames;
+    int32_t res;
+    struct sockaddr_in tmpAddr;
+    uint32_t tmpLen;
+    uint32_t avail;
+
+    frame = reqLocalFrame(maxPayload(), false);
+    frames.reserve(RxBatchSize);
+
+    for (;;) {
+        buff   = *(frame->beginBuffer());
+        avail  = buff->getAvailable();
+        tmpLen = sizeof(struct sockaddr_in);
+
+        res = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC | MSG_DONTWAIT, (struct sockaddr*)&tmpAddr, &tmpLen);
+        if (res < 0) break;
+        if (res == 0) continue;
+
+        // Lock before updating address, update before forwarding so replies reach the sender
+        if (memcmp(&remAddr_, &tmpAddr, sizeof(remAddr_)) != 0) {
+            std::lock_guard<std::mutex> lock(udpMtx_);
+            remAddr_ = tmpAddr;
+        }
+
+        // Message was too big
+        if (static_cast<uint32_t>(res) > avail) {
+            udpLog_->warning("Receive data was too large. Dropping.");
+        } else {
+            buff->setPayload(res);
+            frame->stamp();
+            frames.push_back(frame);
+        }
+
+        // Get new frame
+        frame = reqLocalFrame(maxPayload(), false);
+
+        // Forward a full batch
+        if (frames.size() >= RxBatchSize) {
+            sendFrames(frames);
+            frames.clear();
+        }
+    }
+
+    if (!frames.empty()) sendFrames(frames);
+}
+
 void rpu::Server::setup_python() {
 #ifndef NO_PYTHON
 
     bp::class_<rpu::Server, rpu::ServerPtr, bp::bases<rpu::Core, ris::Master, ris::Slave>, boost::noncopyable>(
         "Server",
         bp::init<uint16_t, bool>())
-        .def("getPort", &rpu::Server::getPort);
+        .def("getPort", &rpu::Server::getPort)
+        .def("setReactor", &rpu::Server::setReactor);
 
     bp::implicitly_convertible<rpu::ServerPtr, rpu::CorePtr>();
     bp::implicitly_convertible<rpu::ServerPtr, ris::MasterPtr>();
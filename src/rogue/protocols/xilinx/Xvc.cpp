@@ -24,11 +24,13 @@
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <memory>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
@@ -54,7 +56,8 @@ rpx::Xvc::Xvc(uint16_t port) : JtagDriver(port), thread_(nullptr), threadEn_(fal
     queue_.setThold(100);
 
     // create logger
-    log_ = rogue::Logging::create("xilinx.xvc");
+    log_       = rogue::Logging::create("xilinx.xvc");
+    threadSet_ = rogue::ThreadSet::create("xilinx.Xvc");
 }
 
 //! Destructor
@@ -69,7 +72,7 @@ void rpx::Xvc::start() {
 
     // Start the thread
     threadEn_ = true;
-    thread_   = new std::thread(&rpx::Xvc::runThread, this);
+    thread_   = threadSet_->start("Xvc", std::bind(&rpx::Xvc::runThread, this));
 }
 
 //! Stop the interface
@@ -81,7 +84,7 @@ void rpx::Xvc::stop() {
     queue_.stop();
 
     // Empty the queue if necessary
-    while (!queue_.empty()) auto f = queue_.pop();
+    queue_.reset();
 
     // Set done flag
     done_ = true;
@@ -94,6 +97,11 @@ void rpx::Xvc::stop() {
     }
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr rpx::Xvc::threads() {
+    return threadSet_;
+}
+
 //! Run driver initialization and XVC thread
 void rpx::Xvc::runThread() {
     // Max message size
@@ -188,7 +196,8 @@ void rpx::Xvc::setup_python() {
         "Xvc",
         bp::init<uint16_t>())
         .def("_start", &rpx::Xvc::start)
-        .def("_stop", &rpx::Xvc::stop);
+        .def("_stop", &rpx::Xvc::stop)
+        .def("threads", &rpx::Xvc::threads);
     bp::implicitly_convertible<rpx::XvcPtr, ris::MasterPtr>();
     bp::implicitly_convertible<rpx::XvcPtr, ris::SlavePtr>();
     bp::implicitly_convertible<rpx::XvcPtr, rpx::JtagDriverPtr>();
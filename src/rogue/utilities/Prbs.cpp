@@ -25,11 +25,14 @@
 
 #include <cstdio>
 #include <cstring>
+#include <functional>
 #include <memory>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Metrics.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
@@ -53,21 +56,25 @@ ru::PrbsPtr ru::Prbs::create() {
 
 //! Creator with default taps and size
 ru::Prbs::Prbs() {
-    txThread_   = NULL;
-    rxSeq_      = 0;
-    rxErrCount_ = 0;
-    rxCount_    = 0;
-    rxBytes_    = 0;
-    rxEnable_   = true;
-    txSeq_      = 0;
-    txSize_     = 0;
-    txErrCount_ = 0;
-    txCount_    = 0;
-    txBytes_    = 0;
-    checkPl_    = true;
-    genPl_      = true;
-    rxLog_      = rogue::Logging::create("prbs.rx");
-    txLog_      = rogue::Logging::create("prbs.tx");
+    txThread_ = NULL;
+    rxSeq_    = 0;
+    rxEnable_ = true;
+    txSeq_    = 0;
+    txSize_   = 0;
+    checkPl_  = true;
+    genPl_    = true;
+    rxLog_    = rogue::Logging::create("prbs.rx");
+    txLog_    = rogue::Logging::create("prbs.tx");
+
+    threadSet_ = rogue::ThreadSet::create("utilities.Prbs");
+
+    metrics_->setPrefix("utilities.Prbs");
+    rxErrCount_ = metrics_->counter("rxErrors");
+    rxCount_    = metrics_->counter("rxCount");
+    rxBytes_    = metrics_->counter("rxBytes");
+    txErrCount_ = metrics_->counter("txErrors");
+    txCount_    = metrics_->counter("txCount");
+    txBytes_    = metrics_->counter("txBytes");
 
     // Init width = 32
     width_     = 32;
@@ -211,12 +218,7 @@ void ru::Prbs::enable(uint32_t size) {
     if (txThread_ == NULL) {
         txSize_   = size;
         threadEn_ = true;
-        txThread_ = new std::thread(&Prbs::runThread, this);
-
-        // Set a thread name
-#ifndef __MACH__
-        pthread_setname_np(txThread_->native_handle(), "PrbsTx");
-#endif
+        txThread_ = threadSet_->start("PrbsTx", std::bind(&ru::Prbs::runThread, this));
     }
 }
 
@@ -231,6 +233,11 @@ void ru::Prbs::disable() {
     }
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr ru::Prbs::threads() {
+    return threadSet_;
+}
+
 //! Get rx enable
 bool ru::Prbs::getRxEnable() {
     return rxEnable_;
@@ -246,27 +253,27 @@ void ru::Prbs::setRxEnable(bool en) {
 
 //! Get RX errors
 uint32_t ru::Prbs::getRxErrors() {
-    return (rxErrCount_);
+    return (static_cast<uint32_t>(rxErrCount_->get()));
 }
 
 //! Get rx count
 uint32_t ru::Prbs::getRxCount() {
-    return (rxCount_);
+    return (static_cast<uint32_t>(rxCount_->get()));
 }
 
 //! Get rx bytes
 uint32_t ru::Prbs::getRxBytes() {
-    return (rxBytes_);
+    return (static_cast<uint32_t>(rxBytes_->get()));
 }
 
 //! Get TX errors
 uint32_t ru::Prbs::getTxErrors() {
-    return (txErrCount_);
+    return (static_cast<uint32_t>(txErrCount_->get()));
 }
 
 //! Get TX count
 uint32_t ru::Prbs::getTxCount() {
-    return (txCount_);
+    return (static_cast<uint32_t>(txCount_->get()));
 }
 
 //! Get rx rate
@@ -291,7 +298,7 @@ double ru::Prbs::getTxBw() {
 
 //! Get TX bytes
 uint32_t ru::Prbs::getTxBytes() {
-    return (txBytes_);
+    return (static_cast<uint32_t>(txBytes_->get()));
 }
 
 //! Set check payload flag, default = true
@@ -308,12 +315,12 @@ void ru::Prbs::genPayload(bool state) {
 // Counters should really be locked!
 void ru::Prbs::resetCount() {
     pMtx_.lock();
-    txErrCount_ = 0;
-    txCount_    = 0;
-    txBytes_    = 0;
-    rxErrCount_ = 0;
-    rxCount_    = 0;
-    rxBytes_    = 0;
+    txErrCount_->set(0);
+    txCount_->set(0);
+    txBytes_->set(0);
+    rxErrCount_->set(0);
+    rxCount_->set(0);
+    rxBytes_->set(0);
     pMtx_.unlock();
 }
 
@@ -381,14 +388,14 @@ void ru::Prbs::genFrame(uint32_t size) {
 
     // Update counters
     txSeq_++;
-    txCount_++;
-    txBytes_ += size;
+    txCount_->inc();
+    txBytes_->inc(size);
 
     if ((per = updateTime(&lastTxTime_)) > 0.0) {
-        txRate_      = static_cast<float>(txCount_ - lastTxCount_) / per;
-        txBw_        = static_cast<float>(txBytes_ - lastTxBytes_) / per;
-        lastTxCount_ = txCount_;
-        lastTxBytes_ = txBytes_;
+        txRate_      = static_cast<float>(txCount_->get() - lastTxCount_) / per;
+        txBw_        = static_cast<float>(txBytes_->get() - lastTxBytes_) / per;
+        lastTxCount_ = txCount_->get();
+        lastTxBytes_ = txBytes_->get();
     }
 }
 
@@ -402,8 +409,11 @@ void ru::Prbs::acceptFrame(ris::FramePtr frame) {
     uint32_t expSize;
     uint32_t size;
     uint32_t pos;
+    uint32_t off;
     uint32_t x;
     uint8_t expData[MaxBytes];
+    uint8_t gotData[MaxBytes];
+    bool good;
     double per;
     char debugA[10000];
     char debugB[1000];
@@ -422,14 +432,16 @@ void ru::Prbs::acceptFrame(ris::FramePtr frame) {
     // Check for frame errors
     if (frame->getError()) {
         rxLog_->warning("Frame error field is set: 0x%" PRIx8, frame->getError());
-        rxErrCount_++;
+        rxErrCount_->inc();
         return;
     }
 
     // Verify size
     if (((size % byteWidth_) != 0) || size < minSize_) {
-        rxLog_->warning("Size violation size=%" PRIu32 ", count=%" PRIu32, size, rxCount_);
-        rxErrCount_++;
+        rxLog_->warning("Size violation size=%" PRIu32 ", count=%" PRIu32,
+                        size,
+                        static_cast<uint32_t>(rxCount_->get()));
+        rxErrCount_->inc();
         return;
     }
 
@@ -453,8 +465,8 @@ void ru::Prbs::acceptFrame(ris::FramePtr frame) {
                         expSeq,
                         frSeq[0],
                         rxSeq_,
-                        rxCount_);
-        rxErrCount_++;
+                        static_cast<uint32_t>(rxCount_->get()));
+        rxErrCount_->inc();
         return;
     }
 
@@ -464,45 +476,54 @@ void ru::Prbs::acceptFrame(ris::FramePtr frame) {
         std::memcpy(expData, frSeq, byteWidth_);
         pos = 0;
 
-        // Read payload
-        while (frIter != frEnd) {
-            flfsr(expData);
+        // Check payload one contiguous span of whole words at a time
+        good = true;
+        ris::forEachSpan(frIter, frEnd - frIter, byteWidth_, [&](uint8_t* data, uint32_t len) -> bool {
+            for (off = 0; off < len; off += byteWidth_) {
+                flfsr(expData);
 
-            if (!std::equal(frIter, frIter + byteWidth_, expData)) {
-                snprintf(debugA,
-                         sizeof(debugA),
-                         "Bad value at index %" PRIu32 ". count=%" PRIu32 ", size=%" PRIu32,
-                         pos,
-                         rxCount_,
-                         (size / byteWidth_) - 1);
-
-                for (x = 0; x < byteWidth_; x++) {
-                    snprintf(debugB,
-                             sizeof(debugB),
-                             "\n   %" PRIu32 ":%" PRIu32 " Got=0x%" PRIx8 " Exp=0x%" PRIx8,
-                             pos,
-                             x,
-                             *(frIter + x),
-                             *(expData + x));
-                    snprintf(debugA + strlen(debugA), sizeof(debugA) - strlen(debugA), "%s", debugB);
+                if (std::memcmp(data + off, expData, byteWidth_) != 0) {
+                    std::memcpy(gotData, data + off, byteWidth_);
+                    good = false;
+                    return false;
                 }
-                rxLog_->warning(debugA);
-                rxErrCount_++;
-                return;
+                ++pos;
+            }
+            return true;
+        });
+
+        if (!good) {
+            snprintf(debugA,
+                     sizeof(debugA),
+                     "Bad value at index %" PRIu32 ". count=%" PRIu32 ", size=%" PRIu32,
+                     pos,
+                     static_cast<uint32_t>(rxCount_->get()),
+                     (size / byteWidth_) - 1);
+
+            for (x = 0; x < byteWidth_; x++) {
+                snprintf(debugB,
+                         sizeof(debugB),
+                         "\n   %" PRIu32 ":%" PRIu32 " Got=0x%" PRIx8 " Exp=0x%" PRIx8,
+                         pos,
+                         x,
+                         *(gotData + x),
+                         *(expData + x));
+                snprintf(debugA + strlen(debugA), sizeof(debugA) - strlen(debugA), "%s", debugB);
             }
-            frIter += byteWidth_;
-            ++pos;
+            rxLog_->warning(debugA);
+            rxErrCount_->inc();
+            return;
         }
     }
 
-    rxCount_++;
-    rxBytes_ += size;
+    rxCount_->inc();
+    rxBytes_->inc(size);
 
     if ((per = updateTime(&lastRxTime_)) > 0.0) {
-        rxRate_      = static_cast<float>(rxCount_ - lastRxCount_) / per;
-        rxBw_        = static_cast<float>(rxBytes_ - lastRxBytes_) / per;
-        lastRxCount_ = rxCount_;
-        lastRxBytes_ = rxBytes_;
+        rxRate_      = static_cast<float>(rxCount_->get() - lastRxCount_) / per;
+        rxBw_        = static_cast<float>(rxBytes_->get() - lastRxBytes_) / per;
+        lastRxCount_ = rxCount_->get();
+        lastRxBytes_ = rxBytes_->get();
     }
 }
 
@@ -513,6 +534,7 @@ void ru::Prbs::setup_python() {
         .def("genFrame", &ru::Prbs::genFrame)
         .def("enable", &ru::Prbs::enable)
         .def("disable", &ru::Prbs::disable)
+        .def("threads", &ru::Prbs::threads)
         .def("setWidth", &ru::Prbs::setWidth)
         .def("setTaps", &ru::Prbs::setTaps)
         .def("getRxEnable", &ru::Prbs::getRxEnable)
@@ -25,6 +25,7 @@
 
 #include <cstdio>
 #include <iostream>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
@@ -32,6 +33,7 @@
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
@@ -59,13 +61,15 @@ void ruf::LegacyStreamReader::setup_python() {
         .def("open", &ruf::LegacyStreamReader::open)
         .def("close", &ruf::LegacyStreamReader::close)
         .def("closeWait", &ruf::LegacyStreamReader::closeWait)
-        .def("isActive", &ruf::LegacyStreamReader::isActive);
+        .def("isActive", &ruf::LegacyStreamReader::isActive)
+        .def("threads", &ruf::LegacyStreamReader::threads);
 #endif
 }
 
 //! Creator
 ruf::LegacyStreamReader::LegacyStreamReader() {
     baseName_   = "";
+    threadSet_  = rogue::ThreadSet::create("fileio.LegacyStreamReader");
     readThread_ = NULL;
     active_     = false;
 }
@@ -95,12 +99,7 @@ void ruf::LegacyStreamReader::open(std::string file) {
 
     active_     = true;
     threadEn_   = true;
-    readThread_ = new std::thread(&LegacyStreamReader::runThread, this);
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(readThread_->native_handle(), "LStreamReader");
-#endif
+    readThread_ = threadSet_->start("LStreamReader", std::bind(&ruf::LegacyStreamReader::runThread, this));
 }
 
 //! Open file
@@ -155,6 +154,11 @@ bool ruf::LegacyStreamReader::isActive() {
     return (active_);
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr ruf::LegacyStreamReader::threads() {
+    return threadSet_;
+}
+
 //! Thread background
 void ruf::LegacyStreamReader::runThread() {
     int32_t ret;
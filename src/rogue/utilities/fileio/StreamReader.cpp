@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include <unistd.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
@@ -30,6 +31,7 @@
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/Threads.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
@@ -57,13 +59,15 @@ void ruf::StreamReader::setup_python() {
         .def("close", &ruf::StreamReader::close)
         .def("isOpen", &ruf::StreamReader::isOpen)
         .def("closeWait", &ruf::StreamReader::closeWait)
-        .def("isActive", &ruf::StreamReader::isActive);
+        .def("isActive", &ruf::StreamReader::isActive)
+        .def("threads", &ruf::StreamReader::threads);
 #endif
 }
 
 //! Creator
 ruf::StreamReader::StreamReader() {
     baseName_   = "";
+    threadSet_  = rogue::ThreadSet::create("fileio.StreamReader");
     readThread_ = NULL;
     active_     = false;
 }
@@ -93,12 +97,7 @@ void ruf::StreamReader::open(std::string file) {
 
     active_     = true;
     threadEn_   = true;
-    readThread_ = new std::thread(&StreamReader::runThread, this);
-
-    // Set a thread name
-#ifndef __MACH__
-    pthread_setname_np(readThread_->native_handle(), "StreamReader");
-#endif
+    readThread_ = threadSet_->start("StreamReader", std::bind(&ruf::StreamReader::runThread, this));
 }
 
 //! Open file
@@ -158,6 +157,11 @@ bool ruf::StreamReader::isActive() {
     return (active_);
 }
 
+//! Get the thread set
+rogue::ThreadSetPtr ruf::StreamReader::threads() {
+    return threadSet_;
+}
+
 //! Thread background
 void ruf::StreamReader::runThread() {
     int32_t ret;
@@ -205,6 +209,7 @@ void ruf::StreamReader::runThread() {
             frame->setFlags(flags);
             frame->setError(error);
             frame->setChannel(chan);
+            frame->stamp();
             it = frame->beginBuffer();
 
             while ((err == false) && (size > 0)) {
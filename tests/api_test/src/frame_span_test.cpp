@@ -0,0 +1,216 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Frame span test
+ *
+ * Builds frames from small fixed size buffers so that words cross buffer
+ * boundaries. Checks the spans passed by forEachSpan() for each word size,
+ * including a final partial word, checks copyFrame() between frames with
+ * different buffer sizes against fromFrame(), and runs Prbs payload checks
+ * over multi buffer frames.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/FrameIterator.h"
+#include "rogue/interfaces/stream/Pool.h"
+#include "rogue/utilities/Prbs.h"
+
+namespace ris = rogue::interfaces::stream;
+namespace ru  = rogue::utilities;
+
+static uint32_t errors = 0;
+
+#define CHECK(cond, ...)                   \
+    do {                                   \
+        if (!(cond)) {                     \
+            printf("Error: " __VA_ARGS__); \
+            printf("\n");                  \
+            errors++;                      \
+        }                                  \
+    } while (0)
+
+// Create a frame of size bytes from buffers of buffSize bytes, filled with a byte pattern
+ris::FramePtr makeFrame(uint32_t buffSize, uint32_t size, uint8_t seed) {
+    std::shared_ptr<ris::Pool> pool = std::make_shared<ris::Pool>();
+    std::vector<uint8_t> data(size);
+    ris::FrameIterator it;
+    ris::FramePtr frame;
+    uint32_t x;
+
+    pool->setFixedSize(buffSize);
+    frame = pool->acceptReq(size, true);
+    frame->setPayload(size);
+
+    for (x = 0; x < size; x++) data[x] = static_cast<uint8_t>(x * 7 + seed);
+
+    it = frame->begin();
+    ris::toFrame(it, size, data.data());
+    return frame;
+}
+
+// Read the whole payload of a frame
+std::vector<uint8_t> readFrame(ris::FramePtr frame) {
+    std::vector<uint8_t> data(frame->getPayload());
+    ris::FrameIterator it = frame->begin();
+
+    ris::fromFrame(it, data.size(), data.data());
+    return data;
+}
+
+// Spans hold whole words, words crossing a buffer are passed alone, a final partial word is last
+void testSpans() {
+    const uint32_t words[]   = {1, 3, 4, 8, 16, 64};
+    const uint32_t buffs[]   = {7, 100, 128};
+    const uint32_t offsets[] = {0, 5};
+    const uint32_t size      = 1001;
+
+    for (uint32_t word : words) {
+        for (uint32_t buff : buffs) {
+            for (uint32_t off : offsets) {
+                ris::FramePtr frame      = makeFrame(buff, size, 1);
+                std::vector<uint8_t> exp = readFrame(frame);
+                ris::FrameIterator it    = frame->begin() + off;
+                uint32_t count           = size - off;
+                std::vector<uint8_t> got;
+                bool last = false;
+                uint32_t total;
+
+                total = ris::forEachSpan(it, count, word, [&](uint8_t* data, uint32_t len) -> bool {
+                    CHECK(!last, "word %u buff %u: span after a partial word", word, buff);
+                    CHECK(len > 0, "word %u buff %u: empty span", word, buff);
+                    if ((len % word) != 0) last = true;
+                    got.insert(got.end(), data, data + len);
+                    return true;
+                });
+
+                CHECK(total == count, "word %u buff %u off %u: visited %u of %u", word, buff, off, total, count);
+                CHECK((it - frame->begin()) == static_cast<int32_t>(size),
+                      "word %u buff %u: iterator not at end",
+                      word,
+                      buff);
+                CHECK(last == ((count % word) != 0), "word %u buff %u off %u: partial word error", word, buff, off);
+                CHECK(got.size() == count && std::equal(got.begin(), got.end(), exp.begin() + off),
+                      "word %u buff %u off %u: data error",
+                      word,
+                      buff,
+                      off);
+            }
+        }
+    }
+
+    // Stopping after the first span advances the iterator past that span only
+    ris::FramePtr frame   = makeFrame(100, size, 1);
+    ris::FrameIterator it = frame->begin();
+    uint32_t first        = 0;
+    uint32_t total        = ris::forEachSpan(it, size, 8, [&](uint8_t* data, uint32_t len) -> bool {
+        first = len;
+        return false;
+    });
+
+    CHECK(total == 96 && first == 96, "early stop visited %u", total);
+    CHECK((it - frame->begin()) == 96, "early stop iterator at %i", it - frame->begin());
+}
+
+// Copies between frames with different buffer sizes must match fromFrame
+void testCopy() {
+    const uint32_t buffs[] = {7, 64, 100, 2000};
+    const uint32_t size    = 1500;
+
+    for (uint32_t srcBuff : buffs) {
+        for (uint32_t dstBuff : buffs) {
+            ris::FramePtr src          = makeFrame(srcBuff, size, 3);
+            ris::FramePtr dst          = makeFrame(dstBuff, size, 0);
+            std::vector<uint8_t> exp   = readFrame(src);
+            ris::FrameIterator srcIter = src->begin() + 11;
+            ris::FrameIterator dstIter = dst->begin() + 29;
+            std::vector<uint8_t> got;
+
+            ris::copyFrame(srcIter, 1000, dstIter);
+            got = readFrame(dst);
+
+            CHECK((srcIter - src->begin()) == 1011 && (dstIter - dst->begin()) == 1029,
+                  "copy %u to %u: iterator error",
+                  srcBuff,
+                  dstBuff);
+            CHECK(std::equal(exp.begin() + 11, exp.begin() + 1011, got.begin() + 29),
+                  "copy %u to %u: data error",
+                  srcBuff,
+                  dstBuff);
+
+            // The destination fills first, the source only advances by the bytes copied
+            srcIter = src->begin() + 100;
+            dstIter = dst->begin() + 1000;
+
+            ris::copyFrame(srcIter, 1000, dstIter);
+            got = readFrame(dst);
+
+            CHECK((srcIter - src->begin()) == 600 && dstIter == dst->end(),
+                  "copy %u to %u: short copy advanced the source to %i",
+                  srcBuff,
+                  dstBuff,
+                  srcIter - src->begin());
+            CHECK(std::equal(exp.begin() + 100, exp.begin() + 600, got.begin() + 1000),
+                  "copy %u to %u: short copy data error",
+                  srcBuff,
+                  dstBuff);
+        }
+    }
+}
+
+// Prbs payload checks over frames of 100 byte buffers, words cross the buffer boundaries
+void testPrbs() {
+    const uint32_t widths[] = {32, 64, 128, 256};
+
+    for (uint32_t width : widths) {
+        ru::PrbsPtr tx = ru::Prbs::create();
+        ru::PrbsPtr rx = ru::Prbs::create();
+        uint32_t bytes = width / 8;
+        uint32_t x;
+
+        tx->setWidth(width);
+        rx->setWidth(width);
+        rx->setFixedSize(100);
+        tx->addSlave(rx);
+
+        for (x = 0; x < 100; x++) tx->genFrame(bytes * (4 + x * 3));
+
+        CHECK(rx->getRxCount() == 100 && rx->getRxErrors() == 0,
+              "prbs width %u: count %u errors %u",
+              width,
+              rx->getRxCount(),
+              rx->getRxErrors());
+    }
+}
+
+int main(int argc, char** argv) {
+    printf("Testing spans\n");
+    testSpans();
+
+    printf("Testing copies\n");
+    testCopy();
+
+    printf("Testing prbs\n");
+    testPrbs();
+
+    if (errors != 0) {
+        printf("Frame span test failed with %u errors\n", errors);
+        return -1;
+    }
+
+    printf("Frame span test passed\n");
+    return 0;
+}
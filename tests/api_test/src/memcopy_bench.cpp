@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Memory copy kernel benchmark
+ *
+ * Measures the throughput of each copy kernel supported by this CPU, with and
+ * without non-temporal stores, against plain memcpy for a range of sizes.
+ * Each kernel is also checked against memcpy with unaligned pointers. The
+ * last test measures how long it takes to re-read a cache resident working
+ * set after copying a 4 MB frame, with and without non-temporal stores.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rogue/MemCopy.h"
+
+// Check a kernel against memcpy, return false on mismatch
+bool checkKernel(rogue::MemCopyKernel kernel, bool stream) {
+    std::vector<uint8_t> src(70000);
+    std::vector<uint8_t> dst(70000);
+    std::vector<uint8_t> ref(70000);
+    uint32_t size;
+    uint32_t off;
+    uint32_t x;
+
+    for (x = 0; x < src.size(); x++) src[x] = rand();
+
+    for (size = 0; size < 66000; size = size * 3 + 1) {
+        for (off = 0; off < 4; off++) {
+            memset(dst.data(), 0, dst.size());
+            memset(ref.data(), 0, ref.size());
+            kernel(dst.data() + off, src.data() + off * 3, size, stream);
+            memcpy(ref.data() + off, src.data() + off * 3, size);
+            if (memcmp(dst.data(), ref.data(), dst.size()) != 0) return false;
+        }
+    }
+    return true;
+}
+
+// Return throughput in GB/s for repeated copies of the passed size
+double runKernel(rogue::MemCopyKernel kernel, bool stream, uint8_t* dst, uint8_t* src, uint32_t size) {
+    uint64_t total = 0;
+    uint64_t target;
+
+    // Keep each measurement at around 1 GB of traffic
+    target = 1ULL << 30;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (total < target) {
+        kernel(dst, src, size, stream);
+        total += size;
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return total / std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// Return the time in ns to read the working set after each copy of the passed size
+double runRetention(bool stream, uint8_t* dst, uint8_t* src, uint32_t size, std::vector<uint64_t>& work) {
+    volatile uint64_t sum = 0;
+    double total          = 0;
+    uint32_t x;
+    uint32_t y;
+
+    for (x = 0; x < 200; x++) {
+        for (y = 0; y < work.size(); y++) sum += work[y];
+
+        rogue::memCopy(dst, src, size, stream);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (y = 0; y < work.size(); y++) sum += work[y];
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        total += std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    return total / 200;
+}
+
+int main(int argc, char** argv) {
+    const char* names[]    = {"memcpy", "avx2", "avx512"};
+    const uint32_t sizes[] = {1024, 8192, 65536, 1048576, 4194304, 33554432};
+    std::vector<uint8_t> src(sizes[5] + 64);
+    std::vector<uint8_t> dst(sizes[5] + 64);
+    rogue::MemCopyKernel kernel;
+    uint32_t x;
+    uint32_t y;
+    uint32_t z;
+
+    printf("Selected kernel: %s\n\n", rogue::memCopyName());
+
+    memset(src.data(), 0x5A, src.size());
+    memset(dst.data(), 0, dst.size());
+
+    printf("Kernel    Stream");
+    for (y = 0; y < 6; y++) printf("  %8u", sizes[y]);
+    printf("  (GB/s)\n");
+
+    for (x = 0; x < 3; x++) {
+        if ((kernel = rogue::memCopyKernel(names[x])) == NULL) {
+            printf("%-8s  not supported\n", names[x]);
+            continue;
+        }
+
+        for (z = 0; z < 2; z++) {
+            if (!checkKernel(kernel, z == 1)) {
+                printf("%-8s  %6s  copy check failed!\n", names[x], (z == 1) ? "yes" : "no");
+                return -1;
+            }
+
+            printf("%-8s  %6s", names[x], (z == 1) ? "yes" : "no");
+            for (y = 0; y < 6; y++) printf("  %8.2f", runKernel(kernel, z == 1, dst.data(), src.data(), sizes[y]));
+            printf("\n");
+        }
+    }
+
+    std::vector<uint64_t> work(32768, 1);
+
+    printf("\nRead 256 KB working set after 4 MB copy: cached %.0f ns, streaming (%s) %.0f ns\n",
+           runRetention(false, dst.data(), src.data(), sizes[4], work),
+           rogue::memCopyName(),
+           runRetention(true, dst.data(), src.data(), sizes[4], work));
+    return 0;
+}
@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Memory copy kernel test
+ *
+ * Checks each copy kernel supported by this CPU, with and without
+ * non-temporal stores, against memcpy. Every size from 0 to MaxSize is copied
+ * with each combination of source and destination misalignment, followed by
+ * a few larger sizes. The bytes around the destination must not change.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "rogue/MemCopy.h"
+
+// Every size up to MaxSize is checked, covering the head, loop and tail of each kernel
+static const uint32_t MaxSize = 1100;
+
+// Guard bytes on each side of the destination
+static const uint32_t Guard = 128;
+
+// Misalignments checked for the source and destination
+static const uint32_t Offsets[] = {0, 1, 7, 31, 33, 63};
+
+static uint32_t errors = 0;
+
+// Copy size bytes with the kernel and with memcpy and compare the destination and guard bytes
+bool checkCopy(rogue::MemCopyKernel kernel,
+               bool stream,
+               const std::vector<uint8_t>& src,
+               std::vector<uint8_t>& dst,
+               std::vector<uint8_t>& ref,
+               uint32_t size,
+               uint32_t srcOff,
+               uint32_t dstOff) {
+    memset(dst.data(), 0xA5, size + Guard * 2 + 64);
+    memset(ref.data(), 0xA5, size + Guard * 2 + 64);
+
+    kernel(dst.data() + Guard + dstOff, src.data() + srcOff, size, stream);
+    memcpy(ref.data() + Guard + dstOff, src.data() + srcOff, size);
+
+    return (memcmp(dst.data(), ref.data(), size + Guard * 2 + 64) == 0);
+}
+
+// Check a kernel, returns the number of failed copies
+uint32_t checkKernel(rogue::MemCopyKernel kernel, bool stream) {
+    const uint32_t large[] = {4095, 65536, 65599, 1048576 + 13};
+    std::vector<uint8_t> src(large[3] + 64);
+    std::vector<uint8_t> dst(large[3] + Guard * 2 + 64);
+    std::vector<uint8_t> ref(large[3] + Guard * 2 + 64);
+    uint32_t fails = 0;
+    uint32_t size;
+    uint32_t x;
+
+    for (x = 0; x < src.size(); x++) src[x] = rand();
+
+    for (size = 0; size <= MaxSize; size++) {
+        for (uint32_t srcOff : Offsets) {
+            for (uint32_t dstOff : Offsets) {
+                if (!checkCopy(kernel, stream, src, dst, ref, size, srcOff, dstOff)) {
+                    if (fails++ < 10) printf("   size %u, src offset %u, dst offset %u failed\n", size, srcOff, dstOff);
+                }
+            }
+        }
+    }
+
+    for (uint32_t lsize : large) {
+        for (uint32_t off : Offsets) {
+            if (!checkCopy(kernel, stream, src, dst, ref, lsize, off, 63 - off)) {
+                if (fails++ < 10) printf("   size %u, src offset %u, dst offset %u failed\n", lsize, off, 63 - off);
+            }
+        }
+    }
+    return fails;
+}
+
+int main(int argc, char** argv) {
+    const char* names[] = {"memcpy", "avx2", "avx512"};
+    rogue::MemCopyKernel kernel;
+    uint32_t fails;
+    uint32_t x;
+    uint32_t z;
+
+    srand(1);
+    printf("Selected kernel: %s\n", rogue::memCopyName());
+
+    for (x = 0; x < 3; x++) {
+        if ((kernel = rogue::memCopyKernel(names[x])) == NULL) {
+            printf("%-8s  not supported\n", names[x]);
+            continue;
+        }
+
+        for (z = 0; z < 2; z++) {
+            fails = checkKernel(kernel, z == 1);
+            printf("%-8s  stream=%i  %s\n", names[x], z, (fails == 0) ? "passed" : "failed");
+            errors += fails;
+        }
+    }
+
+    if (errors != 0) {
+        printf("Memory copy test failed with %u errors\n", errors);
+        return -1;
+    }
+
+    printf("Memory copy test passed\n");
+    return 0;
+}
@@ -0,0 +1,260 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Ring queue test
+ *
+ * Checks the size, maximum and threshold handling of rogue::RingQueue, the
+ * overflow list used once the ring is full, that stop() releases blocked
+ * producers and consumers, and runs multi producer and multi consumer stress
+ * tests with pop() and popN() consumers sharing a small ring, with and without
+ * a maximum. Every entry must be received exactly once and the entries of each
+ * producer must reach each consumer in order.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/RingQueue.h"
+
+static const uint32_t Producers = 4;
+static const uint32_t Consumers = 4;
+static const uint32_t Entries   = 200000;
+static const uint32_t Capacity  = 64;
+
+static std::atomic<uint32_t> errors(0);
+
+#define CHECK(cond, ...)                   \
+    do {                                   \
+        if (!(cond)) {                     \
+            printf("Error: " __VA_ARGS__); \
+            printf("\n");                  \
+            errors++;                      \
+        }                                  \
+    } while (0)
+
+// Entries are (producer << 32) | sequence, sequence starts at one so zero marks a stopped pop()
+static uint64_t entry(uint32_t producer, uint32_t seq) {
+    return (static_cast<uint64_t>(producer) << 32) | seq;
+}
+
+// Single threaded size, maximum and threshold checks
+void testLimits() {
+    rogue::RingQueue<uint64_t> queue(100);
+    std::vector<uint64_t> out;
+    uint32_t x;
+
+    CHECK(queue.capacity() == 128, "capacity rounding, got %u", queue.capacity());
+    CHECK(queue.empty() && queue.size() == 0, "new queue is not empty");
+
+    queue.setThold(10);
+    for (x = 1; x <= 9; x++) queue.push(x);
+    CHECK(!queue.busy(), "busy below threshold");
+
+    queue.push(10);
+    CHECK(queue.busy() && queue.size() == 10, "not busy at threshold, size %u", queue.size());
+
+    queue.setMax(12);
+    queue.push(11);
+    queue.push(12);
+    CHECK(queue.full(), "not full at maximum");
+
+    CHECK(queue.popN(out, 5) == 5 && out[0] == 1 && out[4] == 5, "popN order");
+    CHECK(queue.size() == 7 && !queue.busy() && !queue.full(), "size after popN, got %u", queue.size());
+    CHECK(queue.pop() == 6, "pop order");
+
+    queue.reset();
+    CHECK(queue.empty(), "not empty after reset");
+
+    // Without a maximum entries past the ring capacity go to the overflow list, in order
+    queue.setMax(0);
+    for (x = 0; x < queue.capacity() * 3; x++) queue.push(x);
+    CHECK(!queue.full() && queue.size() == queue.capacity() * 3, "overflow size %u", queue.size());
+
+    out.clear();
+    CHECK(queue.popN(out, queue.capacity() * 2) == queue.capacity() * 2, "overflow popN count");
+    for (x = 0; x < out.size(); x++) CHECK(out[x] == x, "overflow popN order at %u", x);
+
+    for (; x < queue.capacity() * 3; x++) CHECK(queue.pop() == x, "overflow pop order at %u", x);
+    CHECK(queue.empty(), "not empty after overflow");
+
+    // A maximum past the ring capacity is enforced across the overflow list
+    queue.setMax(queue.capacity() + 10);
+    for (x = 0; x < queue.capacity() + 10; x++) queue.push(x);
+    CHECK(queue.full() && queue.size() == queue.capacity() + 10, "not full at maximum past capacity");
+
+    queue.reset();
+    CHECK(queue.empty(), "overflow not cleared by reset");
+}
+
+// stop() must release a consumer waiting on an empty queue and a producer waiting at the maximum
+void testStop() {
+    rogue::RingQueue<uint64_t> empty(Capacity);
+    rogue::RingQueue<uint64_t> full(Capacity);
+    std::vector<uint64_t> out;
+    std::atomic<uint32_t> done(0);
+    uint32_t x;
+
+    full.setMax(Capacity);
+    for (x = 0; x < Capacity; x++) full.push(x + 1);
+
+    std::thread popThread([&] {
+        CHECK(empty.pop() == 0, "pop after stop returned an entry");
+        CHECK(empty.popN(out, 10) == 0, "popN after stop returned entries");
+        done++;
+    });
+
+    std::thread pushThread([&] {
+        full.push(0);
+        done++;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(done == 0, "threads did not block");
+
+    empty.stop();
+    full.stop();
+    popThread.join();
+    pushThread.join();
+
+    CHECK(done == 2, "threads not released by stop");
+
+    // Entries pushed after stop are kept, as with an unbounded queue
+    full.push(0);
+    CHECK(full.size() == Capacity + 2, "push after stop dropped entries, size %u", full.size());
+}
+
+// Multiple producers and consumers, max zero leaves the queue unbounded
+void testStress(uint32_t max) {
+    rogue::RingQueue<uint64_t> queue(Capacity);
+    std::vector<std::vector<uint32_t> > counts(Producers, std::vector<uint32_t>(Entries + 1, 0));
+    std::vector<std::thread> threads;
+    std::atomic<uint64_t> received(0);
+    std::atomic<uint32_t> maxSize(0);
+    std::atomic<bool> run(true);
+    std::mutex mtx;
+    uint32_t x;
+    uint32_t y;
+
+    queue.setThold(Capacity / 2);
+    queue.setMax(max);
+
+    // Half of the consumers use pop(), the other half popN()
+    for (x = 0; x < Consumers; x++) {
+        threads.push_back(std::thread([&, x] {
+            std::vector<uint32_t> last(Producers, 0);
+            std::vector<uint64_t> local;
+            std::vector<uint64_t> out;
+            uint64_t value;
+            uint32_t prod;
+            uint32_t seq;
+
+            for (;;) {
+                out.clear();
+
+                if ((x & 1) == 0) {
+                    if ((value = queue.pop()) == 0) break;
+                    out.push_back(value);
+                } else if (queue.popN(out, 16) == 0) {
+                    break;
+                }
+
+                for (uint64_t v : out) {
+                    prod = v >> 32;
+                    seq  = v & 0xFFFFFFFF;
+
+                    if (prod >= Producers || seq <= last[prod]) {
+                        std::lock_guard<std::mutex> lock(mtx);
+                        CHECK(false, "out of order entry %u:%u after %u", prod, seq, last[prod]);
+                        continue;
+                    }
+                    last[prod] = seq;
+                    local.push_back(v);
+                }
+                received += out.size();
+            }
+
+            std::lock_guard<std::mutex> lock(mtx);
+            for (uint64_t v : local) counts[v >> 32][v & 0xFFFFFFFF]++;
+        }));
+    }
+
+    // Track the largest size, the overflow list lets it pass the ring capacity
+    std::thread monitor([&] {
+        uint32_t size;
+
+        while (run) {
+            size = queue.size();
+            if (size > maxSize) maxSize = size;
+            std::this_thread::yield();
+        }
+    });
+
+    for (x = 0; x < Producers; x++) {
+        threads.push_back(std::thread([&, x] {
+            for (uint32_t seq = 1; seq <= Entries; seq++) queue.push(entry(x, seq));
+        }));
+    }
+
+    // Wait for all entries, then release the consumers
+    for (x = 0; x < 3000 && received < static_cast<uint64_t>(Producers) * Entries; x++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    CHECK(received == static_cast<uint64_t>(Producers) * Entries,
+          "received %lu of %lu entries",
+          static_cast<unsigned long>(received.load()),
+          static_cast<unsigned long>(Producers) * Entries);
+
+    queue.stop();
+    for (auto& thread : threads) thread.join();
+
+    run = false;
+    monitor.join();
+
+    for (x = 0; x < Producers; x++) {
+        for (y = 1; y <= Entries; y++) {
+            if (counts[x][y] != 1) {
+                CHECK(false, "entry %u:%u received %u times", x, y, counts[x][y]);
+                break;
+            }
+        }
+    }
+
+    // Concurrent producers may each pass the maximum check once
+    if (max > 0) CHECK(maxSize <= max + Producers, "size %u exceeded maximum %u", maxSize.load(), max);
+    CHECK(queue.empty() && !queue.busy(), "queue not empty after stress");
+}
+
+int main(int argc, char** argv) {
+    printf("Testing limits\n");
+    testLimits();
+
+    printf("Testing stop\n");
+    testStop();
+
+    printf("Testing %u producers and %u consumers\n", Producers, Consumers);
+    testStress(0);
+
+    printf("Testing %u producers and %u consumers with a maximum\n", Producers, Consumers);
+    testStress(Capacity * 3);
+
+    if (errors != 0) {
+        printf("RingQueue test failed with %u errors\n", errors.load());
+        return -1;
+    }
+
+    printf("RingQueue test passed\n");
+    return 0;
+}
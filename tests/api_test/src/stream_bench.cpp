@@ -0,0 +1,126 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Stream chain benchmark
+ *
+ * Measures the per hop cost of passing a frame through a chain of 1 to 10
+ * pass through stages, each of which is a stream Master and Slave. Frames
+ * are sent one at a time with sendFrame() and in batches with sendFrames().
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace ris = rogue::interfaces::stream;
+
+// Stage which forwards every frame to its slaves
+class Hop : public ris::Master, public ris::Slave {
+  public:
+    void acceptFrame(ris::FramePtr frame) {
+        sendFrame(frame);
+    }
+
+    void acceptFrames(std::vector<ris::FramePtr>& frames) {
+        sendFrames(frames);
+    }
+};
+
+// Final stage which counts frames
+class Sink : public ris::Slave {
+  public:
+    uint64_t count;
+
+    Sink() : count(0) {}
+
+    void acceptFrame(ris::FramePtr frame) {
+        count++;
+    }
+
+    void acceptFrames(std::vector<ris::FramePtr>& frames) {
+        count += frames.size();
+    }
+};
+
+// Batch size used for sendFrames()
+const uint32_t BatchSize = 64;
+
+// Send frames through a chain of the passed length, return the time per frame in ns
+double runChain(uint32_t stages, uint32_t frames, bool batch) {
+    std::vector<std::shared_ptr<Hop> > hops;
+    std::shared_ptr<ris::Master> src = ris::Master::create();
+    std::shared_ptr<Sink> sink       = std::make_shared<Sink>();
+    std::shared_ptr<ris::Master> last = src;
+    uint32_t x;
+
+    for (x = 0; x < stages; x++) {
+        std::shared_ptr<Hop> hop = std::make_shared<Hop>();
+        last->addSlave(hop);
+        hops.push_back(hop);
+        last = hop;
+    }
+    last->addSlave(sink);
+
+    ris::FramePtr frame = src->reqFrame(64, true);
+    frame->setPayload(64);
+
+    std::vector<ris::FramePtr> list(BatchSize, frame);
+    frames -= frames % BatchSize;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (batch) {
+        for (x = 0; x < frames; x += BatchSize) src->sendFrames(list);
+    } else {
+        for (x = 0; x < frames; x++) src->sendFrame(frame);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    if (sink->count != frames) fprintf(stderr, "Frame count mismatch: %" PRIu64 " != %u\n", sink->count, frames);
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / frames;
+}
+
+int main(int argc, char** argv) {
+    uint32_t frames = 1000000;
+    uint32_t stages;
+    double base[2];
+    double cur[2];
+    uint32_t x;
+
+    if (argc > 1) frames = strtoul(argv[1], NULL, 0);
+
+    // Warm up
+    runChain(1, frames / 10, false);
+
+    for (x = 0; x < 2; x++) base[x] = runChain(1, frames, x == 1);
+
+    printf("                 sendFrame               sendFrames(%u)\n", BatchSize);
+    printf("Stages    ns/frame    ns/hop    ns/frame    ns/hop\n");
+    printf("%6u  %10.1f         -  %10.1f         -\n", 1, base[0], base[1]);
+
+    for (stages = 2; stages <= 10; stages++) {
+        for (x = 0; x < 2; x++) cur[x] = runChain(stages, frames, x == 1);
+        printf("%6u  %10.1f  %8.1f  %10.1f  %8.1f\n",
+               stages,
+               cur[0],
+               (cur[0] - base[0]) / (stages - 1),
+               cur[1],
+               (cur[1] - base[1]) / (stages - 1));
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Batch slave test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import time
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+FrameCount = 1000
+BatchCount = 100
+
+class ListSlave(rogue.interfaces.stream.BatchSlave):
+
+    def __init__(self, maxCount, maxTime, delay=0):
+        rogue.interfaces.stream.BatchSlave.__init__(self, maxCount, maxTime)
+        self.sizes  = []
+        self.values = []
+        self.delay  = delay
+
+    def _acceptFrames(self, frames):
+        self.sizes.append(len(frames))
+        time.sleep(self.delay)
+
+        for frame in frames:
+            self.values.append(int.from_bytes(frame.getNumpy(0,4).tobytes(),'little'))
+
+def wait_values(slv, count):
+    for _ in range(100):
+        if len(slv.values) == count:
+            break
+        time.sleep(.1)
+
+def batch_count():
+    src = rogue.interfaces.stream.Master()
+    slv = ListSlave(BatchCount, 1000000)
+
+    src >> slv
+
+    # Frames are held here until the test completes
+    frames = []
+
+    for i in range(FrameCount):
+        frame = src._reqFrame(4, True)
+        frame.write(bytearray(i.to_bytes(4,'little')))
+        frames.append(frame)
+        src._sendFrame(frame)
+
+    wait_values(slv, FrameCount)
+
+    if slv.values != list(range(FrameCount)):
+        raise AssertionError('Frame order error')
+
+    # Batches complete on count, only the last batch completes on time. A slow
+    # delivery thread may take everything queued as a single batch.
+    if sum(slv.sizes) != FrameCount or min(slv.sizes[:-1], default=BatchCount) < BatchCount:
+        raise AssertionError('Batch size error. Got = {}'.format(slv.sizes))
+
+    if slv.batchCnt() != len(slv.sizes):
+        raise AssertionError('Batch count error. Got = {}'.format(slv.batchCnt()))
+
+def batch_time():
+    src = rogue.interfaces.stream.Master()
+    slv = ListSlave(BatchCount, 1000)
+
+    src >> slv
+
+    frames = []
+
+    # The time window completes partial batches
+    for i in range(5):
+        frame = src._reqFrame(4, True)
+        frame.write(bytearray(i.to_bytes(4,'little')))
+        frames.append(frame)
+        src._sendFrame(frame)
+
+    wait_values(slv, 5)
+
+    if slv.values != list(range(5)):
+        raise AssertionError('Time window error. Got = {}'.format(slv.values))
+
+def send_frames(src, count):
+    for i in range(count):
+        frame = src._reqFrame(4, True)
+        frame.write(bytearray(i.to_bytes(4,'little')))
+        src._sendFrame(frame)
+
+def batch_depth():
+    src = rogue.interfaces.stream.Master()
+    slv = ListSlave(BatchCount, 1000, .01)
+
+    src >> slv
+
+    # The sender waits for a slow receiver, the queue never exceeds the limit
+    slv.setMaxDepth(BatchCount // 2, False)
+    send_frames(src, FrameCount)
+    wait_values(slv, FrameCount)
+
+    if slv.values != list(range(FrameCount)) or slv.dropCnt() != 0:
+        raise AssertionError('Blocking depth error. Got {} frames, {} dropped'.format(len(slv.values),slv.dropCnt()))
+
+    if max(slv.sizes) > BatchCount // 2:
+        raise AssertionError('Depth limit exceeded. Got = {}'.format(max(slv.sizes)))
+
+def batch_drop():
+    src = rogue.interfaces.stream.Master()
+    slv = ListSlave(BatchCount, 1000, .1)
+
+    src >> slv
+
+    # Frames are dropped once the limit is reached
+    slv.setMaxDepth(BatchCount // 2, True)
+    send_frames(src, FrameCount)
+
+    for _ in range(100):
+        if len(slv.values) + slv.dropCnt() == FrameCount:
+            break
+        time.sleep(.1)
+
+    if slv.dropCnt() == 0 or len(slv.values) + slv.dropCnt() != FrameCount:
+        raise AssertionError('Drop error. Got {} frames, {} dropped'.format(len(slv.values),slv.dropCnt()))
+
+    if slv.values != sorted(slv.values) or max(slv.sizes) > BatchCount // 2:
+        raise AssertionError('Drop order or depth error')
+
+def test_batch_count():
+    batch_count()
+
+def test_batch_time():
+    batch_time()
+
+def test_batch_depth():
+    batch_depth()
+
+def test_batch_drop():
+    batch_drop()
+
+if __name__ == "__main__":
+    test_batch_count()
+    test_batch_time()
+    test_batch_depth()
+    test_batch_drop()
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Demux test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import time
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+Channels = 64
+FrameCount = 10
+
+class ChanSlave(rogue.interfaces.stream.Slave):
+
+    def __init__(self):
+        rogue.interfaces.stream.Slave.__init__(self)
+        self.channels = []
+
+    def _acceptFrame(self, frame):
+        self.channels.append(frame.getChannel())
+
+def demux_route():
+    src   = rogue.interfaces.stream.Master()
+    demux = rogue.interfaces.stream.Demux()
+    dst   = [ChanSlave() for _ in range(Channels)]
+
+    src >> demux
+
+    # Odd channels have no output
+    for ch in range(0,Channels,2):
+        demux.output(ch) >> dst[ch]
+
+    # Errored frames are only dropped on channel 0
+    demux.setDropErrors(0,True)
+
+    for i in range(FrameCount):
+        for ch in range(Channels):
+            frame = src._reqFrame(4, True)
+            frame.write(bytearray(4))
+            frame.setChannel(ch)
+            frame.setError(1 if i == 0 else 0)
+            src._sendFrame(frame)
+
+    for ch in range(0,Channels,2):
+        exp = FrameCount - 1 if ch == 0 else FrameCount
+
+        if dst[ch].channels != [ch] * exp:
+            raise AssertionError('Channel {} error. Got = {}'.format(ch,dst[ch].channels))
+
+    if demux.dropCnt(0) != 1 or demux.dropCnt(2) != 0:
+        raise AssertionError('Drop count error. Got = {} {}'.format(demux.dropCnt(0),demux.dropCnt(2)))
+
+    if demux.unmatchedCnt() != FrameCount * Channels // 2:
+        raise AssertionError('Unmatched count error. Got = {}'.format(demux.unmatchedCnt()))
+
+def demux_batch():
+    src   = rogue.interfaces.stream.Master()
+    fifo  = rogue.interfaces.stream.Fifo(0,0,False)
+    demux = rogue.interfaces.stream.Demux()
+    dst   = [ChanSlave() for _ in range(2)]
+
+    # The Fifo forwards queued frames in batches
+    src >> fifo >> demux
+    demux.output(0) >> dst[0]
+    demux.output(1) >> dst[1]
+
+    # Runs of frames on the same channel
+    sends = [0] * 5 + [1] * 3 + [0] * 2 + [1] * 7
+
+    for ch in sends:
+        frame = src._reqFrame(4, True)
+        frame.write(bytearray(4))
+        frame.setChannel(ch)
+        src._sendFrame(frame)
+
+    for i in range(100):
+        if len(dst[0].channels) + len(dst[1].channels) == len(sends):
+            break
+        time.sleep(.1)
+
+    if dst[0].channels != [0] * 7 or dst[1].channels != [1] * 10:
+        raise AssertionError('Batch route error. Got = {} {}'.format(dst[0].channels,dst[1].channels))
+
+def test_demux_route():
+    demux_route()
+
+def test_demux_batch():
+    demux_batch()
+
+if __name__ == "__main__":
+    test_demux_route()
+    test_demux_batch()
@@ -12,6 +12,7 @@
 #-----------------------------------------------------------------------------
 import rogue.interfaces.stream
 import rogue
+import threading
 import time
 
 #rogue.Logging.setLevel(rogue.Logging.Debug)
@@ -51,8 +52,121 @@ def fifo_path():
 
     print("Done testing")
 
+class SlowSlave(rogue.interfaces.stream.Slave):
+
+    def __init__(self, delay):
+        rogue.interfaces.stream.Slave.__init__(self)
+        self._delay = delay
+        self.count  = 0
+
+    def _acceptFrame(self, frame):
+        time.sleep(self._delay)
+        self.count += 1
+
+def fifo_backpressure():
+    src  = rogue.interfaces.stream.Master()
+    fifo = rogue.interfaces.stream.Fifo(10,0,False)
+    dst  = SlowSlave(0.001)
+
+    src >> fifo >> dst
+
+    fifo.setBackpressure(8,2,0)
+
+    for _ in range(200):
+        frame = src._reqFrame(100, True)
+        frame.write(bytearray(100))
+        src._sendFrame(frame)
+
+    for i in range(300):
+        if dst.count == 200:
+            break
+        time.sleep(.1)
+
+    if fifo.dropCnt() != 0 or dst.count != 200:
+        raise AssertionError('Backpressure drop error. Dropped = {} Received = {}'.format(fifo.dropCnt(),dst.count))
+
+    if fifo.blockCnt() == 0 or fifo.blockTime() == 0:
+        raise AssertionError('Backpressure block count error. Count = {}'.format(fifo.blockCnt()))
+
+    # Bounded wait drops frames the consumer can not keep up with
+    fifo.clearCnt()
+    dst._delay = 0.05
+    fifo.setBackpressure(4,1,1000)
+
+    for _ in range(20):
+        frame = src._reqFrame(100, True)
+        frame.write(bytearray(100))
+        src._sendFrame(frame)
+
+    if fifo.dropCnt() == 0:
+        raise AssertionError('Backpressure timeout error')
+
+    # Let the consumer drain before the objects are released
+    for i in range(100):
+        if fifo.size() == 0:
+            break
+        time.sleep(.1)
+    time.sleep(.1)
+
+class GateSlave(rogue.interfaces.stream.Slave):
+
+    def __init__(self):
+        rogue.interfaces.stream.Slave.__init__(self)
+        self.gate  = threading.Event()
+        self.count = 0
+
+    def _acceptFrame(self, frame):
+        self.gate.wait()
+        self.count += 1
+
+def fifo_capacity():
+    src  = rogue.interfaces.stream.Master()
+    fifo = rogue.interfaces.stream.Fifo(0,0,False)
+    dst  = GateSlave()
+
+    src >> fifo >> dst
+
+    # An unbounded FIFO must take every frame without blocking, the worker holds at most one batch
+    count = 5000
+
+    def send():
+        for _ in range(count):
+            frame = src._reqFrame(1, True)
+            frame.write(bytearray(1))
+            src._sendFrame(frame)
+
+    thread = threading.Thread(target=send)
+    thread.start()
+    thread.join(30)
+
+    alive = thread.is_alive()
+    size  = fifo.size()
+
+    # Release the receiver before checking so that a failure does not leave the sender blocked
+    dst.gate.set()
+    thread.join()
+
+    if alive or size < count - 64:
+        raise AssertionError('Capacity error. Size = {} Sender blocked = {}'.format(size,alive))
+
+    for i in range(100):
+        if dst.count == count:
+            break
+        time.sleep(.1)
+
+    if dst.count != count or fifo.dropCnt() != 0:
+        raise AssertionError('Capacity frame error. Received = {} Dropped = {}'.format(dst.count,fifo.dropCnt()))
+
 def test_fifo_path():
     fifo_path()
 
+def test_fifo_backpressure():
+    fifo_backpressure()
+
+def test_fifo_capacity():
+    fifo_capacity()
+
 if __name__ == "__main__":
     test_fifo_path()
+    test_fifo_backpressure()
+    test_fifo_capacity()
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Steady state frame allocation test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import time
+
+FrameSize  = 1000
+BurstCount = 100
+
+def send_bursts(src, dst, count):
+    for _ in range(count):
+        start = dst.getFrameCount()
+
+        for _ in range(BurstCount):
+            frame = src._reqFrame(FrameSize, True)
+            frame.write(bytearray(FrameSize))
+            src._sendFrame(frame)
+
+        del frame
+
+        # Wait for the burst to drain so the number of frames in flight stays bounded
+        for i in range(100):
+            if dst.getFrameCount() == start + BurstCount:
+                break
+            time.sleep(.01)
+
+        if dst.getFrameCount() != start + BurstCount:
+            raise AssertionError('Frame count error. Got = {}'.format(dst.getFrameCount() - start))
+
+def frame_alloc():
+    src  = rogue.interfaces.stream.Master()
+    fifo = rogue.interfaces.stream.Fifo(0,0,False)
+    dst  = rogue.interfaces.stream.Slave()
+
+    src >> fifo >> dst
+
+    # Buffers come from fixed size pools
+    for pool in [fifo, dst]:
+        pool.setFixedSize(FrameSize)
+        pool.setPoolSize(1000)
+
+    # Grow the free lists past what a burst can hold. Released frames collect in the
+    # receive thread cache, so the lists must cover a full thread cache plus a burst.
+    frames = [src._reqFrame(FrameSize, True) for _ in range(1024)]
+    del frames
+
+    send_bursts(src, dst, 10)
+
+    count = rogue.interfaces.stream.Frame.getHeapAllocCount()
+    send_bursts(src, dst, 100)
+
+    if rogue.interfaces.stream.Frame.getHeapAllocCount() != count:
+        raise AssertionError('Heap allocations in steady state. Got = {}'.format(
+            rogue.interfaces.stream.Frame.getHeapAllocCount() - count))
+
+    if fifo.getAllocCount() != 0 or dst.getAllocCount() != 0:
+        raise AssertionError('Buffers not returned')
+
+def test_frame_alloc():
+    frame_alloc()
+
+if __name__ == "__main__":
+    test_frame_alloc()
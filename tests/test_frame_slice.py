@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Frame slice test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+
+FrameSize = 1000
+
+def frame_slice(fixedSize):
+
+    # Pool with small fixed size buffers so slices span multiple buffers, 0 for single buffer frames
+    pool = rogue.interfaces.stream.Slave()
+    pool.setFixedSize(fixedSize)
+    pool.setPoolSize(100)
+
+    mst = rogue.interfaces.stream.Master()
+    mst >> pool
+
+    data  = bytearray([i % 256 for i in range(FrameSize)])
+    frame = mst._reqFrame(FrameSize, True)
+    frame.write(data)
+    frame.setChannel(3)
+
+    for offset, size in [(0, FrameSize), (10, 20), (63, 2), (333, 500), (FrameSize - 1, 1)]:
+        slc = frame.slice(offset, size)
+
+        if slc.getPayload() != size:
+            raise AssertionError('Slice size error. Got = {} expected = {}'.format(slc.getPayload(), size))
+
+        if slc.getBa() != data[offset:offset + size]:
+            raise AssertionError('Slice data error at offset = {} size = {}'.format(offset, size))
+
+        if slc.getChannel() != 3:
+            raise AssertionError('Slice channel error')
+
+    # Slices share data with the original frame
+    slc = frame.slice(100, 50)
+    slc.write(bytearray(50))
+    if frame.getBa(100, 50) != bytearray(50):
+        raise AssertionError('Slice write not visible in frame')
+
+    # Slice of a slice
+    sub = slc.slice(10, 10)
+    frame.write(bytearray([0xAA] * 10), 110)
+    if sub.getBa() != bytearray([0xAA] * 10):
+        raise AssertionError('Nested slice data error')
+
+    # Buffers referenced by slices are returned to the pool only after the slices are released
+    del frame
+    if pool.getAllocCount() == 0:
+        raise AssertionError('Buffers released while slices exist')
+
+    del slc, sub
+    if pool.getAllocCount() != 0:
+        raise AssertionError('Buffers not released. Count = {}'.format(pool.getAllocCount()))
+
+    try:
+        frame = mst._reqFrame(10, True)
+        frame.write(bytearray(10))
+        frame.slice(5, 10)
+        raise AssertionError('Out of range slice did not fail')
+    except rogue.GeneralError:
+        pass
+
+def test_frame_slice():
+    frame_slice(64)
+    frame_slice(0)
+
+if __name__ == "__main__":
+    test_frame_slice()
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Frame numpy view test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import numpy as np
+
+FrameSize = 1000
+
+def frame_view(fixedSize):
+
+    # Pool with small fixed size buffers for multi buffer frames, 0 for single buffer frames
+    pool = rogue.interfaces.stream.Slave()
+    pool.setFixedSize(fixedSize)
+    pool.setPoolSize(100)
+
+    mst = rogue.interfaces.stream.Master()
+    mst >> pool
+
+    data  = bytearray([i % 256 for i in range(FrameSize)])
+    frame = mst._reqFrame(FrameSize, True)
+    frame.write(data)
+
+    view = frame.getNumpyView()
+
+    # Multi buffer frames return one array per buffer
+    if isinstance(view, tuple):
+        if fixedSize == 0:
+            raise AssertionError('Single buffer frame returned a tuple')
+        arr = np.concatenate(view)
+    else:
+        if fixedSize != 0:
+            raise AssertionError('Multi buffer frame returned an array')
+        arr = view
+
+    if arr.tobytes() != data:
+        raise AssertionError('View data error')
+
+    # Writes through the view are visible in the frame
+    first = view[0] if isinstance(view, tuple) else view
+    first[0:4] = 0xAA
+    if frame.getBa(0, 4) != bytearray([0xAA] * 4):
+        raise AssertionError('View write not visible in frame')
+
+    # The view keeps the frame and its buffers alive
+    del frame
+    if pool.getAllocCount() == 0:
+        raise AssertionError('Buffers released while view exists')
+
+    if first[0] != 0xAA:
+        raise AssertionError('View data error after frame release')
+
+    del view, first, arr
+    if pool.getAllocCount() != 0:
+        raise AssertionError('Buffers not released. Count = {}'.format(pool.getAllocCount()))
+
+def frame_view_dtype():
+    mst   = rogue.interfaces.stream.Master()
+    frame = mst._reqFrame(16, True)
+    frame.putNumpy(np.arange(4, dtype=np.uint32))
+
+    view = frame.getNumpyView(dtype=np.dtype(np.uint32))
+    if list(view) != [0, 1, 2, 3]:
+        raise AssertionError('Typed view error. Got = {}'.format(view))
+
+    frame = mst._reqFrame(16, True)
+    frame.write(bytearray(6))
+    try:
+        frame.getNumpyView(dtype=np.dtype(np.uint32))
+        raise AssertionError('Misaligned view did not fail')
+    except rogue.GeneralError:
+        pass
+
+def test_frame_view():
+    frame_view(64)
+    frame_view(0)
+    frame_view_dtype()
+
+if __name__ == "__main__":
+    test_frame_view()
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Stream latency tracing test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import time
+
+FrameCount = 1000
+
+def histogram():
+    hist = rogue.Histogram()
+
+    for v in [1, 10, 100, 1000, 10000, 100000]:
+        hist.record(v)
+
+    if hist.getCount() != 6 or hist.getMin() != 1 or hist.getMax() != 100000:
+        raise AssertionError('Histogram stats error. Count = {} Min = {} Max = {}'.format(hist.getCount(),hist.getMin(),hist.getMax()))
+
+    # Percentiles are accurate to the bucket resolution of 1/16
+    p50 = hist.getPercentile(50)
+    if p50 < 100 or p50 > 107:
+        raise AssertionError('Histogram percentile error. P50 = {}'.format(p50))
+
+    if hist.getPercentile(100) != 100000:
+        raise AssertionError('Histogram percentile error. P100 = {}'.format(hist.getPercentile(100)))
+
+    hist.reset()
+    if hist.getCount() != 0 or hist.getMax() != 0:
+        raise AssertionError('Histogram reset error')
+
+def tracing():
+    src  = rogue.interfaces.stream.Master()
+    fifo = rogue.interfaces.stream.Fifo(0,0,False)
+    dst  = rogue.interfaces.stream.Slave()
+
+    src >> fifo >> dst
+
+    src.setTracing(True)
+    fifo.setTracing(True)
+
+    for _ in range(FrameCount):
+        frame = src._reqFrame(100, True)
+        frame.write(bytearray(100))
+        frame.stamp()
+        src._sendFrame(frame)
+
+    # Untimestamped frames are not recorded
+    frame = src._reqFrame(100, True)
+    frame.write(bytearray(100))
+    src._sendFrame(frame)
+
+    for i in range(100):
+        if dst.getFrameCount() == FrameCount + 1:
+            break
+        time.sleep(.1)
+
+    src.setTracing(False)
+    fifo.setTracing(False)
+
+    for name, hist in [('src', src.getLatency(0)), ('fifo', fifo.getLatency(0))]:
+        if hist.getCount() != FrameCount:
+            raise AssertionError('{} latency count error. Got = {} expected = {}'.format(name,hist.getCount(),FrameCount))
+
+    # The fifo edge includes the time spent in the queue
+    if fifo.getLatency(0).getMax() < src.getLatency(0).getMin():
+        raise AssertionError('Latency order error')
+
+def tracing_toggle():
+    src = rogue.interfaces.stream.Master()
+    dst = rogue.interfaces.stream.Slave()
+
+    src >> dst
+
+    # Toggling reuses the published snapshot
+    for _ in range(1000):
+        src.setTracing(True)
+        src.setTracing(False)
+
+    src.setTracing(True)
+
+    # A slave added while tracing gets a new histogram, the existing one is kept
+    src >> rogue.interfaces.stream.Slave()
+
+    for _ in range(10):
+        frame = src._reqFrame(100, True)
+        frame.write(bytearray(100))
+        frame.stamp()
+        src._sendFrame(frame)
+
+    for x in range(2):
+        if src.getLatency(x).getCount() != 10:
+            raise AssertionError('Slave {} latency count error. Got = {}'.format(x,src.getLatency(x).getCount()))
+
+def test_histogram():
+    histogram()
+
+def test_tracing():
+    tracing()
+
+def test_tracing_toggle():
+    tracing_toggle()
+
+if __name__ == "__main__":
+    test_histogram()
+    test_tracing()
+    test_tracing_toggle()
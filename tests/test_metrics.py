@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Metrics registry test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import time
+
+FrameCount = 100
+
+def registry():
+    src  = rogue.interfaces.stream.Master()
+    fifo = rogue.interfaces.stream.Fifo(10,0,False)
+    dst  = rogue.interfaces.stream.Slave()
+
+    src >> fifo >> dst
+
+    fifo.setMetricsPath('Root.Fifo')
+    dst.setMetricsPath('Root.Dst')
+
+    if fifo.getMetricsPath() != 'Root.Fifo':
+        raise AssertionError('Metrics path error. Got = {}'.format(fifo.getMetricsPath()))
+
+    for _ in range(FrameCount):
+        frame = src._reqFrame(100, True)
+        frame.write(bytearray(100))
+        src._sendFrame(frame)
+
+    for i in range(100):
+        if dst.getFrameCount() + fifo.dropCnt() == FrameCount:
+            break
+        time.sleep(.1)
+
+    snap = rogue.Metrics.snapshot('Root.')
+
+    exp = {'Root.Dst.frameCount' : dst.getFrameCount(),
+           'Root.Dst.frameBytes' : dst.getByteCount(),
+           'Root.Fifo.dropCount' : fifo.dropCnt()}
+
+    for k,v in exp.items():
+        if snap.get(k) != v:
+            raise AssertionError('Metric {} error. Got = {} expected = {}'.format(k,snap.get(k),v))
+
+    if snap['Root.Dst.frameCount'] + snap['Root.Fifo.dropCount'] != FrameCount:
+        raise AssertionError('Frame count error. Got = {}'.format(snap['Root.Dst.frameCount']))
+
+    for k in snap:
+        if not (k.startswith('Root.Fifo.') or k.startswith('Root.Dst.')):
+            raise AssertionError('Prefix filter error. Got = {}'.format(k))
+
+    # Metrics are removed when the owner is destroyed, frames hold a reference to their pool
+    count = rogue.Metrics.count()
+    del frame
+    del fifo
+    del src
+
+    if rogue.Metrics.count() > count - 6:
+        raise AssertionError('Metrics not removed. Count = {}'.format(rogue.Metrics.count()))
+
+    if list(rogue.Metrics.snapshot('Root.').keys()) != list(rogue.Metrics.snapshot('Root.Dst.').keys()):
+        raise AssertionError('Stale metric in snapshot')
+
+def default_path():
+    fifo = rogue.interfaces.stream.Fifo(0,0,False)
+    path = fifo.getMetricsPath()
+
+    if not path.startswith('stream.Fifo['):
+        raise AssertionError('Default path error. Got = {}'.format(path))
+
+    if (path + '.dropCount') not in rogue.Metrics.snapshot('stream.Fifo['):
+        raise AssertionError('Default metric missing')
+
+def lazy_registration():
+    # Objects which publish nothing take no space in the registry
+    count = rogue.Metrics.count()
+    src   = rogue.interfaces.stream.Master()
+    fifo  = rogue.interfaces.stream.Fifo(0,0,False)
+    dst   = rogue.interfaces.stream.Slave()
+
+    if rogue.Metrics.count() != count + 3:
+        raise AssertionError('Unused metrics registered. Got = {} expected = {}'.format(rogue.Metrics.count(),count + 3))
+
+    # Frame and allocation metrics are registered once used
+    src >> dst
+
+    frame = src._reqFrame(100, True)
+    frame.write(bytearray(100))
+    src._sendFrame(frame)
+
+    snap = rogue.Metrics.snapshot(dst.getMetricsPath() + '.')
+
+    for k in ['frameCount', 'frameBytes', 'allocBytes', 'allocCount', 'cacheMiss']:
+        if (dst.getMetricsPath() + '.' + k) not in snap:
+            raise AssertionError('Metric {} missing'.format(k))
+
+    # Sub-classes do not take instance indexes under the base class prefix
+    pathA = rogue.interfaces.stream.Slave().getMetricsPath()
+    rogue.interfaces.stream.Fifo(0,0,False).getMetricsPath()
+    pathB = rogue.interfaces.stream.Slave().getMetricsPath()
+
+    indexA = int(pathA[len('stream.Slave['):-1])
+    indexB = int(pathB[len('stream.Slave['):-1])
+
+    if indexB != indexA + 1:
+        raise AssertionError('Index error. Got = {} after {}'.format(pathB,pathA))
+
+def test_registry():
+    registry()
+
+def test_default_path():
+    default_path()
+
+def test_lazy_registration():
+    lazy_registration()
+
+if __name__ == "__main__":
+    test_registry()
+    test_default_path()
+    test_lazy_registration()
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Parallel fifo test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import time
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+FrameCount = 10000
+FrameSize  = 10000
+
+def parallel_fifo_path():
+
+    # PRBS
+    prbsTx = rogue.utilities.Prbs()
+    prbsRx = rogue.utilities.Prbs()
+
+    # Parallel FIFO with 4 workers and ordered output
+    pfifo = rogue.interfaces.stream.ParallelFifo(0,4,True)
+
+    # Worker stage
+    filt = rogue.interfaces.stream.Filter(False,0)
+
+    # Client stream, PRBS receiver checks the frame order
+    prbsTx >> pfifo >> filt >> pfifo.output() >> prbsRx
+
+    prbsRx.checkPayload(True)
+
+    print("Generating Frames")
+    for _ in range(FrameCount):
+        prbsTx.genFrame(FrameSize)
+
+    # Wait at least 30 seconds for frames to go through
+    for i in range(300):
+        if prbsRx.getRxCount() == FrameCount:
+            break
+        time.sleep(.1)
+
+    if prbsRx.getRxErrors() != 0:
+        raise AssertionError('PRBS Frame errors detected! Errors = {}'.format(prbsRx.getRxErrors()))
+
+    if prbsRx.getRxCount() != FrameCount:
+        raise AssertionError('Frame count error. Got = {} expected = {}'.format(prbsRx.getRxCount(),FrameCount))
+
+    if pfifo.output().pending() != 0:
+        raise AssertionError('Reorder buffer not empty. Pending = {}'.format(pfifo.output().pending()))
+
+    print("Done testing")
+
+def test_parallel_fifo_path():
+    parallel_fifo_path()
+
+if __name__ == "__main__":
+    test_parallel_fifo_path()
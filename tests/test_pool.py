@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Stream frame pool test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import ctypes
+import ctypes.util
+import threading
+import time
+import numpy as np
+
+BufferSize = 2000
+ArenaSize  = 1 << 20
+FrameCount = 100
+
+# Address of the first buffer of a frame
+def buffer_address(frame):
+    return frame.getNumpyView(np.dtype(np.uint8)).__array_interface__['data'][0]
+
+# Release a list of frames in a new thread, the thread exits once done is set
+def release_thread(frames, done):
+    released = threading.Event()
+
+    def run(lst):
+        lst.clear()
+        released.set()
+        done.wait()
+
+    thread = threading.Thread(target=run, args=(frames,))
+    thread.start()
+    released.wait()
+    return thread
+
+# The thread cache is released after join() returns, when the native thread exits
+def wait_for(cond):
+    for _ in range(100):
+        if cond():
+            return True
+        time.sleep(0.01)
+    return False
+
+# Bytes of heap memory in use, None when not available from the C library
+def heap_used():
+    libc = ctypes.CDLL(ctypes.util.find_library('c'))
+
+    class MallInfo(ctypes.Structure):
+        _fields_ = [(name, ctypes.c_size_t) for name in
+                    ['arena', 'ordblks', 'smblks', 'hblks', 'hblkhd', 'usmblks', 'fsmblks', 'uordblks', 'fordblks', 'keepcost']]
+
+    if not hasattr(libc, 'mallinfo2'):
+        return None
+
+    libc.mallinfo2.restype = MallInfo
+    info = libc.mallinfo2()
+    return info.uordblks + info.hblkhd
+
+def pool_cache_depth():
+    mst  = rogue.interfaces.stream.Master()
+    pool = rogue.interfaces.stream.Slave()
+
+    mst >> pool
+
+    pool.setFixedSize(BufferSize)
+    pool.setPoolSize(FrameCount)
+
+    # Depth zero disables the thread caches
+    pool.setCacheDepth(0)
+
+    if pool.getCacheDepth() != 0:
+        raise AssertionError('Cache depth error. Got = {}'.format(pool.getCacheDepth()))
+
+    for _ in range(2):
+        frames = [mst._reqFrame(BufferSize, True) for _ in range(FrameCount)]
+        del frames
+
+    if pool.getCacheMissCount() != 0:
+        raise AssertionError('Cache used with depth zero. Misses = {}'.format(pool.getCacheMissCount()))
+
+    # Each refill moves half the depth from the pool
+    pool.setCacheDepth(16)
+
+    frames = [mst._reqFrame(BufferSize, True) for _ in range(FrameCount)]
+    addrs  = set(buffer_address(frame) for frame in frames)
+    del frames
+
+    miss   = pool.getCacheMissCount()
+    frames = [mst._reqFrame(BufferSize, True) for _ in range(FrameCount)]
+
+    if pool.getCacheMissCount() - miss > (FrameCount // 8) + 1:
+        raise AssertionError('Cache refill error. Misses = {}'.format(pool.getCacheMissCount() - miss))
+
+    if set(buffer_address(frame) for frame in frames) != addrs:
+        raise AssertionError('Cached buffers were not reused')
+
+    del frames
+
+    if pool.getAllocCount() != 0:
+        raise AssertionError('Buffers not returned. Count = {}'.format(pool.getAllocCount()))
+
+def pool_cross_thread():
+    mst  = rogue.interfaces.stream.Master()
+    pool = rogue.interfaces.stream.Slave()
+
+    mst >> pool
+
+    pool.setFixedSize(BufferSize)
+    pool.setPoolSize(FrameCount)
+    pool.setCacheDepth(16)
+
+    # Allocated here, released by another thread
+    frames = [mst._reqFrame(BufferSize, True) for _ in range(FrameCount)]
+    addrs  = set(buffer_address(frame) for frame in frames)
+    done   = threading.Event()
+    thread = release_thread(frames, done)
+
+    if pool.getAllocCount() != 0:
+        raise AssertionError('Buffers not returned. Count = {}'.format(pool.getAllocCount()))
+
+    # The releasing thread drains the rest of its cache when it exits
+    miss = pool.getCacheMissCount()
+    done.set()
+    thread.join()
+
+    if not wait_for(lambda: pool.getCacheMissCount() > miss):
+        raise AssertionError('Thread cache not drained on thread exit')
+
+    frames = [mst._reqFrame(BufferSize, True) for _ in range(FrameCount)]
+
+    if set(buffer_address(frame) for frame in frames) != addrs:
+        raise AssertionError('Buffers released by another thread were not reused')
+
+    del frames
+
+def pool_destroy():
+    size = 32768
+    base = heap_used()
+
+    if base is None:
+        return
+
+    mst  = rogue.interfaces.stream.Master()
+    pool = rogue.interfaces.stream.Slave()
+
+    mst >> pool
+
+    pool.setFixedSize(size)
+    pool.setPoolSize(FrameCount)
+    pool.setCacheDepth(FrameCount * 2)
+
+    # All buffers end up in the cache of the releasing thread
+    frames = [mst._reqFrame(size, True) for _ in range(FrameCount)]
+    done   = threading.Event()
+    thread = release_thread(frames, done)
+
+    # The pool goes away while the thread still caches its buffers
+    del mst, pool
+    done.set()
+    thread.join()
+
+    # Cached buffers are freed when the thread exits
+    if not wait_for(lambda: heap_used() - base < (size * FrameCount) // 2):
+        raise AssertionError('Thread cache not released with the pool. Used = {}'.format(heap_used() - base))
+
+def pool_arena():
+    mst  = rogue.interfaces.stream.Master()
+    pool = rogue.interfaces.stream.Slave()
+
+    mst >> pool
+
+    # Fixed size mode is required
+    try:
+        pool.setArena(ArenaSize, False, -1, False)
+        raise AssertionError('Arena created without fixed size mode')
+    except rogue.GeneralError:
+        pass
+
+    pool.setFixedSize(BufferSize)
+    pool.setPoolSize(100)
+
+    # Leave buffers in this thread's cache before the arena is created
+    frames = [mst._reqFrame(BufferSize, True) for _ in range(10)]
+    del frames
+
+    pool.setArena(ArenaSize, False, -1, False)
+
+    # Buffers are cache line aligned
+    count = ArenaSize // (((BufferSize + 63) // 64) * 64)
+
+    if pool.getArenaSize() != count:
+        raise AssertionError('Arena size error. Got = {} expected = {}'.format(pool.getArenaSize(),count))
+
+    try:
+        pool.setArena(ArenaSize, False, -1, False)
+        raise AssertionError('Arena created twice')
+    except rogue.GeneralError:
+        pass
+
+    try:
+        pool.setFixedSize(BufferSize * 2)
+        raise AssertionError('Fixed size changed with an arena')
+    except rogue.GeneralError:
+        pass
+
+    # The cache left under the old pool id is drained on the next use
+    miss   = pool.getCacheMissCount()
+    frames = [mst._reqFrame(BufferSize, True)]
+
+    if pool.getCacheMissCount() < miss + 2:
+        raise AssertionError('Stale thread cache was not drained')
+
+    # Allocate and free the whole arena twice
+    for _ in range(2):
+        frames = [mst._reqFrame(BufferSize, True) for _ in range(count)]
+
+        if pool.getAllocCount() != count:
+            raise AssertionError('Alloc count error. Got = {} expected = {}'.format(pool.getAllocCount(),count))
+
+        for i, frame in enumerate(frames):
+            frame.write(bytearray([i & 0xFF]) * BufferSize)
+
+        for i, frame in enumerate(frames):
+            if frame.getNumpy(0, BufferSize).tolist() != [i & 0xFF] * BufferSize:
+                raise AssertionError('Arena buffer {} corrupted'.format(i))
+
+        del frames, frame
+
+        if pool.getAllocCount() != 0:
+            raise AssertionError('Buffers not returned. Count = {}'.format(pool.getAllocCount()))
+
+def test_pool_cache_depth():
+    pool_cache_depth()
+
+def test_pool_cross_thread():
+    pool_cross_thread()
+
+def test_pool_destroy():
+    pool_destroy()
+
+def test_pool_arena():
+    pool_arena()
+
+if __name__ == "__main__":
+    test_pool_cache_depth()
+    test_pool_cross_thread()
+    test_pool_destroy()
+    test_pool_arena()
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Priority FIFO test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import threading
+import time
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+FrameSize = 4096
+
+class GateSlave(rogue.interfaces.stream.Slave):
+    """Records the channel of each frame, holding the first frame until released"""
+
+    def __init__(self):
+        rogue.interfaces.stream.Slave.__init__(self)
+        self.gate     = threading.Event()
+        self.channels = []
+
+    def _acceptFrame(self, frame):
+        self.gate.wait()
+        self.channels.append(frame.getChannel())
+
+def run(pfifo, sends, total):
+    src = rogue.interfaces.stream.Master()
+    dst = GateSlave()
+
+    src >> pfifo >> dst
+
+    # Frames are held here until the test completes
+    frames = []
+
+    # The first frame blocks in the destination while the rest queue up
+    for chan in sends:
+        frame = src._reqFrame(FrameSize, True)
+        frame.write(bytearray(FrameSize))
+        frame.setChannel(chan)
+        frames.append(frame)
+        src._sendFrame(frame)
+
+        if len(frames) == 1:
+            time.sleep(.1)
+
+    dst.gate.set()
+
+    for i in range(100):
+        if len(dst.channels) == total:
+            break
+        time.sleep(.1)
+
+    if len(dst.channels) != total:
+        raise AssertionError('Frame count error. Got = {} expected = {}'.format(len(dst.channels),total))
+
+    return dst.channels[1:]
+
+def strict_priority():
+    pfifo = rogue.interfaces.stream.PriorityFifo(2,False)
+    pfifo.setChannel(0,0)
+
+    # Control frames on channel 0 overtake the queued bulk frames on channel 1
+    got = run(pfifo, [1] + [1] * 20 + [0] * 5, 26)
+
+    if got[:5] != [0] * 5:
+        raise AssertionError('Priority order error. Got = {}'.format(got))
+
+def weighted_fair():
+    pfifo = rogue.interfaces.stream.PriorityFifo(2,True)
+    pfifo.setChannel(0,0)
+    pfifo.setClass(0,0,3)
+    pfifo.setClass(1,0,1)
+
+    # Equal size frames are served at a 3:1 ratio while both classes are backlogged
+    got = run(pfifo, [1] + [1] * 40 + [0] * 40, 81)
+
+    if got[:20].count(0) != 15:
+        raise AssertionError('Weighted order error. Got = {}'.format(got[:20]))
+
+def class_depth():
+    pfifo = rogue.interfaces.stream.PriorityFifo(2,False)
+    pfifo.setChannel(0,0)
+    pfifo.setClass(1,5,1)
+
+    # Only the bulk class is limited, frames queued behind the blocked frame are dropped
+    got = run(pfifo, [1] + [1] * 10 + [0] * 10, 16)
+
+    if pfifo.dropCnt(1) != 5 or pfifo.dropCnt(0) != 0:
+        raise AssertionError('Drop count error. Got = {} {}'.format(pfifo.dropCnt(0),pfifo.dropCnt(1)))
+
+    if got.count(0) != 10:
+        raise AssertionError('Control frames lost. Got = {}'.format(got))
+
+def test_strict_priority():
+    strict_priority()
+
+def test_weighted_fair():
+    weighted_fair()
+
+def test_class_depth():
+    class_depth()
+
+if __name__ == "__main__":
+    test_strict_priority()
+    test_weighted_fair()
+    test_class_depth()
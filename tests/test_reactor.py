@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Reactor test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.utilities
+import rogue.protocols.udp
+import rogue.interfaces.stream
+import rogue
+import time
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+FrameCount = 5000
+FrameSize  = 10000
+
+def data_path(busyPoll):
+    print("Testing busyPoll={}".format(busyPoll))
+
+    reactor = rogue.Reactor(2)
+    reactor.setBusyPoll(busyPoll)
+
+    # UDP server and client both receive through the reactor
+    serv = rogue.protocols.udp.Server(0,True)
+    client = rogue.protocols.udp.Client("127.0.0.1",serv.getPort(),True)
+
+    serv.setReactor(reactor)
+    client.setReactor(reactor)
+
+    if reactor.count() != 2:
+        raise AssertionError('Reactor count error. Got = {} expected = 2'.format(reactor.count()))
+
+    # RSSI and packetizer
+    sRssi = rogue.protocols.rssi.Server(serv.maxPayload())
+    cRssi = rogue.protocols.rssi.Client(client.maxPayload())
+    sPack = rogue.protocols.packetizer.CoreV2(True,True,True)
+    cPack = rogue.protocols.packetizer.CoreV2(True,True,True)
+
+    # PRBS
+    prbsTx = rogue.utilities.Prbs()
+    prbsRx = rogue.utilities.Prbs()
+
+    prbsTx >> cPack.application(0)
+    cRssi.application() == cPack.transport()
+    cRssi.transport() == client
+
+    serv == sRssi.transport()
+    sRssi.application() == sPack.transport()
+    sPack.application(0) >> prbsRx
+
+    sRssi._start()
+    cRssi._start()
+
+    # Wait for connection
+    cnt = 0
+    while not cRssi.getOpen():
+        time.sleep(1)
+        cnt += 1
+
+        if cnt == 10:
+            cRssi._stop()
+            sRssi._stop()
+            raise AssertionError('RSSI timeout error. busyPoll={}'.format(busyPoll))
+
+    for _ in range(FrameCount):
+        prbsTx.genFrame(FrameSize)
+
+    for _ in range(100):
+        if prbsRx.getRxCount() == FrameCount:
+            break
+        time.sleep(.1)
+
+    cRssi._stop()
+    sRssi._stop()
+
+    serv._stop()
+    client._stop()
+
+    if reactor.count() != 0:
+        raise AssertionError('Reactor count error after stop. Got = {}'.format(reactor.count()))
+
+    if prbsRx.getRxCount() != FrameCount:
+        raise AssertionError('Frame count error. Got = {} expected = {}'.format(prbsRx.getRxCount(),FrameCount))
+
+    if prbsRx.getRxErrors() != 0:
+        raise AssertionError('PRBS Frame errors detected!')
+
+def test_data_path():
+    data_path(0)
+    data_path(50)
+
+if __name__ == "__main__":
+    test_data_path()
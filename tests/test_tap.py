@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Tap test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import threading
+import time
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+FrameCount = 100
+
+class SlowMonitor(rogue.interfaces.stream.Slave):
+    """Records the first byte of each frame, blocking on the first frame until released"""
+
+    def __init__(self):
+        rogue.interfaces.stream.Slave.__init__(self)
+        self.gate   = threading.Event()
+        self.values = []
+
+    def _acceptFrame(self, frame):
+        self.gate.wait()
+        self.values.append(frame.getNumpy(0,1)[0])
+
+def tap_latest():
+    src  = rogue.interfaces.stream.Master()
+    prim = rogue.interfaces.stream.Slave()
+    tap  = rogue.interfaces.stream.Tap()
+    mon  = SlowMonitor()
+
+    src >> prim
+    src >> tap >> mon
+
+    # Frames are held here until the test completes
+    frames = []
+
+    # The monitor blocks on the first frame, the primary path must not
+    for i in range(FrameCount):
+        frame = src._reqFrame(4, True)
+        frame.write(bytearray([i,0,0,0]))
+        frames.append(frame)
+        src._sendFrame(frame)
+
+        if i == 0:
+            time.sleep(.1)
+
+    if prim.getFrameCount() != FrameCount:
+        raise AssertionError('Primary count error. Got = {}'.format(prim.getFrameCount()))
+
+    mon.gate.set()
+
+    for _ in range(100):
+        if len(mon.values) == 2:
+            break
+        time.sleep(.1)
+
+    # The monitor gets the first frame and then only the latest frame
+    if mon.values != [0, FrameCount-1]:
+        raise AssertionError('Monitor frames error. Got = {}'.format(mon.values))
+
+    if tap.skipCnt() != FrameCount - 2:
+        raise AssertionError('Skip count error. Got = {}'.format(tap.skipCnt()))
+
+def test_tap_latest():
+    tap_latest()
+
+if __name__ == "__main__":
+    test_tap_latest()
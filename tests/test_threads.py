@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Thread registry test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue_example software. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue_example software, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream
+import rogue
+import os
+import time
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+def find(path):
+    return [t for t in rogue.Threads.list() if t['path'] == path]
+
+def thread_list():
+    fifo = rogue.interfaces.stream.Fifo(0,0,False)
+    path = fifo.threads().getPath()
+
+    # Thread id is recorded once the thread runs
+    for i in range(100):
+        if find(path) and find(path)[0]['tid'] != 0:
+            break
+        time.sleep(.01)
+
+    info = find(path)
+
+    if len(info) != 1 or info[0]['name'] != 'Fifo' or info[0]['tid'] == 0:
+        raise AssertionError('Thread list error. Got = {}'.format(info))
+
+    if fifo.threads().getIds() != [info[0]['tid']]:
+        raise AssertionError('Thread id error. Got = {}'.format(fifo.threads().getIds()))
+
+    del fifo
+
+    if find(path):
+        raise AssertionError('Stale thread entry for {}'.format(path))
+
+def thread_affinity():
+    pfifo = rogue.interfaces.stream.ParallelFifo(0,2,False)
+    cpu   = sorted(os.sched_getaffinity(0))[-1]
+
+    pfifo.threads().setAffinity([cpu])
+
+    info = find(pfifo.threads().getPath())
+
+    if len(info) != 2 or any(t['cpus'] != [cpu] for t in info):
+        raise AssertionError('Affinity error. Got = {}'.format(info))
+
+    # An empty list restores the process affinity
+    pfifo.threads().setAffinity([])
+
+    if pfifo.threads().getAffinity() != []:
+        raise AssertionError('Affinity not cleared')
+
+    if any(t['cpus'] != sorted(os.sched_getaffinity(0)) for t in find(pfifo.threads().getPath())):
+        raise AssertionError('Affinity not restored')
+
+def test_thread_list():
+    thread_list()
+
+def test_thread_affinity():
+    thread_affinity()
+
+if __name__ == "__main__":
+    test_thread_list()
+    test_thread_affinity()